@@ -0,0 +1,85 @@
+/*!
+    @file       BinaryBTPUScheduler.h
+    @brief      Scheduler per l'utilizzo di piu' istanze della BTPU su una stessa moltiplicazione.
+    @details    Ogni istanza e' descritta da una voce della tabella dei dispositivi (registri e memorie W/IO).
+                I tile dell'uscita vengono suddivisi in job e assegnati dinamicamente alla prima istanza che termina
+                il job precedente: job di righe di blocchi intere se le righe bastano per tutte le istanze, altrimenti
+                (es. strisce da 32 righe) job di un blocco riga e di un gruppo di blocchi colonna. I pesi restano
+                residenti nella memoria W di ogni istanza, memorizzati per pannelli di colonne della larghezza dei job,
+                e non vengono ricaricati finche' non cambiano. La tabella dei dispositivi (BTPUDevice_t) e' di sola lettura: lo stato
+                di ogni istanza e' tenuto nello scheduler. Le istanze emulate eseguono i job in software, cosi' lo
+                scheduler puo' essere provato anche su Linux (vedi test/btpuSchedulerTest.c).
+
+    @author     Alan Masutti  (@alanmasu)
+    @date       18/10/2026
+*/
+
+#ifndef __BINARY_BTPU_SCHEDULER_H__
+#define __BINARY_BTPU_SCHEDULER_H__
+
+#include <BinaryMatMul.h>
+
+#ifndef BTPU_SCHEDULER_JOBS_PER_DEVICE
+#define BTPU_SCHEDULER_JOBS_PER_DEVICE 4    ///< Job per istanza da generare, per bilanciare il carico
+#endif
+
+#ifndef BTPU_SCHEDULER_MAX_DEVICES
+#define BTPU_SCHEDULER_MAX_DEVICES 4        ///< Numero massimo di istanze gestite da uno scheduler
+#endif
+
+/// Stato dello scheduler relativo a un'istanza
+typedef struct BTPUDeviceState_t {
+    const uint32_t*         residentWeights;    ///< Matrice B caricata in wMemory (NULL se nessuna)
+    uint32_t                residentN;          ///< Righe della matrice B residente (in bit)
+    uint32_t                residentK;          ///< Colonne della matrice B residente (in bit)
+    uint32_t                residentPanelCols;  ///< Larghezza dei pannelli di colonne di B residente (in blocchi)
+    int32_t                 jobBlockRow;        ///< Prima riga di blocchi del job in corso (-1 se libera)
+    uint32_t                jobBlockRows;       ///< Righe di blocchi del job in corso
+    uint32_t                jobBlockCol;        ///< Primo blocco colonna del job in corso
+    uint32_t                jobBlockCols;       ///< Blocchi colonna del job in corso
+    uint32_t                completedJobs;      ///< Job completati dall'istanza
+} BTPUDeviceState_t;
+
+typedef struct BTPUScheduler_t {
+    const BTPUDevice_t*     devices;                            ///< Tabella dei dispositivi
+    uint32_t                count;                              ///< Numero di istanze nella tabella
+    BTPUDeviceState_t       state[BTPU_SCHEDULER_MAX_DEVICES];  ///< Stato di ogni istanza, nello stesso ordine
+} BTPUScheduler_t;
+
+/*!
+    @brief  Inizializza lo scheduler su una tabella di dispositivi
+    @details Azzera lo stato di residenza e i contatori di ogni istanza. La tabella non viene modificata.
+    @param[out] sched Lo scheduler
+    @param      devices La tabella dei dispositivi (deve restare valida)
+    @param      count Numero di istanze nella tabella (al massimo BTPU_SCHEDULER_MAX_DEVICES)
+    @return true se lo scheduler e' stato inizializzato, false se count non e' valido
+*/
+bool btpuSchedulerInit(BTPUScheduler_t* sched, const BTPUDevice_t* devices, uint32_t count);
+
+/*!
+    @brief  Invalida i pesi residenti di tutte le istanze
+    @details Da chiamare se il contenuto di una matrice B gia' usata e' stato modificato o se la memoria W di
+             un'istanza e' stata scritta al di fuori dello scheduler.
+*/
+void btpuSchedulerInvalidateWeights(BTPUScheduler_t* sched);
+
+/*!
+    @brief      Moltiplica due matrici binarie applicando il segno su tutte le istanze della tabella
+    @details    L'uscita viene divisa in job di righe di blocchi, o di blocchi colonna quando le righe di blocchi sono
+                meno delle istanze; ogni istanza libera riceve il prossimo job, quindi le istanze piu' veloci ne
+                eseguono di piu'. B viene caricata per intero nella memoria W di un'istanza solo se non e' gia'
+                residente con la stessa larghezza dei pannelli, cosi' ogni istanza puo' eseguire qualsiasi job.
+    @param      sched Lo scheduler
+    @param[in]  a La matrice binaria A
+    @param[in]  b La matrice binaria B
+    @param[out] c La matrice risultante
+    @param      signCmp Il valore di confronto per il segno
+    @param      m Numero di righe della matrice A (in bit)
+    @param      n Numero di colonne della matrice A e righe della matrice B (in bit)
+    @param      k Numero di colonne della matrice B (in bit)
+    @return     true se la moltiplicazione e' stata completata, false se le matrici non entrano nelle memorie
+                o in caso di errore di un'istanza
+*/
+bool btpuSchedulerMatrixMul(BTPUScheduler_t* sched, const BinaryMatrix_t a, const BinaryMatrix_t b, BinaryMatrix_t c, uint32_t signCmp, const int m, const int n, const int k);
+
+#endif // __BINARY_BTPU_SCHEDULER_H__
@@ -0,0 +1,89 @@
+/*!
+    @file       BinaryBatchedMatMul.h
+    @brief      Moltiplicazione batched di matrici binarie con pesi preparati.
+    @details    Versione software della modalita' BATCHED_MUL della BTPU: i frammenti dei pesi vengono
+                caricati e trasposti una sola volta e condivisi da tutti gli input del batch, cosi' che il costo
+                di preparazione sia pagato una volta per batch e non ad ogni chiamata di binaryMatrixMul.
+
+    @author     Alan Masutti  (@alanmasu)
+    @date       18/10/2026
+*/
+
+#ifndef __BINARY_BATCHED_MATMUL_H__
+#define __BINARY_BATCHED_MATMUL_H__
+
+#include <BinaryMatMul.h>
+
+typedef struct BinaryWeights_t {
+    BinaryFragment_t* frags;    ///< Frammenti trasposti di B, frags[blockCol * blockN + i] e' il blocco (i, blockCol)
+    uint32_t          n;        ///< Numero di righe della matrice B (in bit)
+    uint32_t          k;        ///< Numero di colonne della matrice B (in bit)
+} BinaryWeights_t;
+
+/*!
+    @brief  Prepara i frammenti dei pesi per le moltiplicazioni batched
+    @details Carica e traspone ogni frammento di B una sola volta. I frammenti di uno stesso blocco colonna
+             sono contigui, in modo che il pannello di pesi usato da un tile di uscita sia letto in sequenza.
+    @param[out] w I pesi preparati
+    @param[in]  b La matrice binaria B
+    @param      n Numero di righe della matrice B (in bit)
+    @param      k Numero di colonne della matrice B (in bit)
+    @return     true se l'allocazione e' andata a buon fine, false altrimenti
+*/
+bool prepareBinaryWeights(BinaryWeights_t* w, const BinaryMatrix_t b, uint32_t n, uint32_t k);
+
+/// Libera i frammenti allocati con prepareBinaryWeights
+void freeBinaryWeights(BinaryWeights_t* w);
+
+/*!
+    @brief  Moltiplica una matrice binaria per dei pesi preparati
+    @param[in]  a La matrice binaria A (m x n bit)
+    @param[in]  w I pesi preparati (n x k bit)
+    @param[out] result La matrice risultante (m x k)
+    @param      m Numero di righe della matrice A (in bit)
+*/
+void binaryMatrixMulPrepared(const BinaryMatrix_t a, const BinaryWeights_t* w, Matrix_t result, uint32_t m);
+
+/*!
+    @brief  Moltiplica una matrice binaria per dei pesi preparati applicando il segno
+    @param[in]  a La matrice binaria A (m x n bit)
+    @param[in]  w I pesi preparati (n x k bit)
+    @param[out] c La matrice binaria risultante (m x k bit)
+    @param      signCmp Il valore di confronto per il segno
+    @param      m Numero di righe della matrice A (in bit)
+*/
+void fastBinaryMatrixMulPrepared(const BinaryMatrix_t a, const BinaryWeights_t* w, BinaryMatrix_t c, uint32_t signCmp, uint32_t m);
+
+/*!
+    @brief      Moltiplica un batch di matrici binarie
+    @details    Calcola result[b] = a[b] * w[b] per ogni elemento del batch. Con un solo set di pesi (wCount = 1)
+                il ciclo esterno scorre i blocchi colonna dei pesi e quello interno gli input del batch, cosi' che il
+                pannello di pesi resti in cache per tutto il batch; con pesi diversi per ogni input il batch viene
+                elaborato un input alla volta e ogni input usa le dimensioni n e k dei propri pesi.
+    @param[in]  a Array di batch matrici binarie A (m x n bit)
+    @param[in]  w Array di pesi preparati (n x k bit), di lunghezza 1 o batch
+    @param      wCount Numero di set di pesi: 1 (condivisi) oppure batch
+    @param[out] result Array strided delle matrici risultanti: l'uscita b parte da result + b * resultStride
+    @param      resultStride Distanza tra due uscite consecutive (in elementi, almeno m * k per il k piu' grande)
+    @param      batch Numero di input del batch
+    @param      m Numero di righe di ogni matrice A (in bit)
+    @return     true se la moltiplicazione e' stata eseguita, false se batch e' 0 o wCount non e' valido
+*/
+bool binaryMatrixMulBatched(const BinaryMatrix_t a[], const BinaryWeights_t w[], uint32_t wCount, Matrix_t result, uint32_t resultStride, uint32_t batch, uint32_t m);
+
+/*!
+    @brief      Moltiplica un batch di matrici binarie applicando il segno
+    @details    Come binaryMatrixMulBatched, ma il risultato viene binarizzato con signCmp.
+    @param[in]  a Array di batch matrici binarie A (m x n bit)
+    @param[in]  w Array di pesi preparati (n x k bit), di lunghezza 1 o batch
+    @param      wCount Numero di set di pesi: 1 (condivisi) oppure batch
+    @param[out] c Array strided delle matrici binarie risultanti: l'uscita b parte da c + b * cStride
+    @param      cStride Distanza tra due uscite consecutive (in parole, almeno m * k / 32 per il k piu' grande)
+    @param      signCmp Il valore di confronto per il segno
+    @param      batch Numero di input del batch
+    @param      m Numero di righe di ogni matrice A (in bit)
+    @return     true se la moltiplicazione e' stata eseguita, false se batch e' 0 o wCount non e' valido
+*/
+bool fastBinaryMatrixMulBatched(const BinaryMatrix_t a[], const BinaryWeights_t w[], uint32_t wCount, BinaryMatrix_t c, uint32_t cStride, uint32_t signCmp, uint32_t batch, uint32_t m);
+
+#endif // __BINARY_BATCHED_MATMUL_H__
@@ -0,0 +1,47 @@
+/*!
+    @file       BinaryClassifier.h
+    @brief      Testa di classificazione binaria fusa: punteggi XNOR-popcount e top-k senza matrice di uscita.
+    @details    I punteggi di ogni riga di input vengono calcolati a blocchi con binaryBlockMatrixMul e consumati
+                subito dall'accumulatore: per ogni riga viene mantenuta solo la classifica corrente dei migliori topK
+                (indice, punteggio), quindi memoria e traffico di uscita sono O(m * topK) invece di O(m * k).
+
+    @author     Alan Masutti  (@alanmasu)
+    @date       18/10/2026
+*/
+
+#ifndef __BINARY_CLASSIFIER_H__
+#define __BINARY_CLASSIFIER_H__
+
+#include <BinaryMatMul.h>
+#include <BinaryBatchedMatMul.h>
+
+#define BINARY_TOPK_MAX 8   ///< Numero massimo di classi restituite per riga
+
+/*!
+    @brief      Calcola le topK classi con punteggio XNOR-popcount piu' alto per ogni riga
+    @details    Equivale a binaryMatrixMul seguita da una ricerca dei massimi per riga, senza memorizzare la matrice
+                dei punteggi. A parita' di punteggio vince la classe con indice minore.
+    @param[in]  a La matrice binaria degli input (m x n bit)
+    @param[in]  w I pesi preparati del layer denso (n x k bit), vedi prepareBinaryWeights
+    @param      m Numero di righe della matrice A (in bit)
+    @param      classes Numero di classi valide (<= k): le colonne successive sono padding e vengono ignorate
+    @param      topK Numero di classi da restituire per riga (1..BINARY_TOPK_MAX, non oltre classes)
+    @param[out] indices Indici delle classi (m x topK), in ordine di punteggio decrescente
+    @param[out] scores Punteggi corrispondenti (m x topK), puo' essere NULL
+    @return     true se il calcolo e' stato eseguito, false se topK o classes non sono validi
+*/
+bool binaryClassifierTopK(const BinaryMatrix_t a, const BinaryWeights_t* w, uint32_t m, uint32_t classes, uint32_t topK, uint32_t* indices, uint32_t* scores);
+
+/*!
+    @brief      Calcola la classe con punteggio piu' alto per ogni riga
+    @details    Equivale a binaryClassifierTopK con topK = 1.
+    @param[in]  a La matrice binaria degli input (m x n bit)
+    @param[in]  w I pesi preparati del layer denso (n x k bit)
+    @param      m Numero di righe della matrice A (in bit)
+    @param      classes Numero di classi valide (<= k)
+    @param[out] indices Indice della classe vincente per ogni riga (m elementi)
+    @return     true se il calcolo e' stato eseguito, false se classes non e' valido
+*/
+bool binaryClassifierArgmax(const BinaryMatrix_t a, const BinaryWeights_t* w, uint32_t m, uint32_t classes, uint32_t* indices);
+
+#endif // __BINARY_CLASSIFIER_H__
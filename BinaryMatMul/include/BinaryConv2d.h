@@ -0,0 +1,92 @@
+/*!
+    @file       BinaryConv2d.h
+    @brief      Convoluzione 2D binaria sui kernel a frammenti, senza materializzare l'im2col.
+    @details    Le feature map sono bit-packed in formato channels-last: il bit del canale c del pixel (y, x)
+                si trova alla posizione (y * inW + x) * inC + c dello stream di bit (MSB first, come getBit).
+                Ogni riga di un frammento A viene costruita al volo estraendo con degli shift i bit della finestra
+                del filtro. Le parole im2col di una riga di 32 pixel vengono tenute in un workspace del chiamante
+                (2 * filterWords frammenti, allocato una volta con binaryConv2dAllocWorkspace), non nell'intera
+                matrice im2col.
+
+    @author     Alan Masutti  (@alanmasu)
+    @date       18/10/2026
+*/
+
+#ifndef __BINARY_CONV2D_H__
+#define __BINARY_CONV2D_H__
+
+#include <BinaryMatMul.h>
+
+typedef struct BinaryConv2dParams_t {
+    uint32_t inH;       ///< Altezza della feature map di ingresso (in pixel)
+    uint32_t inW;       ///< Larghezza della feature map di ingresso (in pixel)
+    uint32_t inC;       ///< Numero di canali di ingresso (in bit, qualsiasi valore)
+    uint32_t outC;      ///< Numero di canali di uscita (multiplo di 32)
+    uint32_t kH;        ///< Altezza del filtro
+    uint32_t kW;        ///< Larghezza del filtro
+    uint32_t stride;    ///< Passo della convoluzione (>= 1)
+    uint32_t pad;       ///< Padding applicato su tutti i bordi
+    uint32_t poolSize;  ///< Lato del max-pool binario fuso (0 o 1 per disabilitarlo)
+} BinaryConv2dParams_t;
+
+typedef struct BinaryConv2dWorkspace_t {
+    BinaryFragment_t* aPanel;       ///< Parole im2col della riga di blocchi corrente (filterWords frammenti)
+    BinaryFragment_t* padPanel;     ///< Bit di padding delle stesse parole (filterWords frammenti)
+    bool*             hasPad;       ///< hasPad[i] e' true se la parola i contiene bit di padding (filterWords voci)
+    uint32_t          filterWords;  ///< Numero di parole per filtro supportato dal workspace
+} BinaryConv2dWorkspace_t;
+
+/*!
+    @brief  Calcola le dimensioni della feature map di uscita
+    @details Se poolSize > 1 le dimensioni restituite sono quelle dopo il max-pool.
+    @param[in]  params I parametri della convoluzione
+    @param[out] outH Altezza dell'uscita (in pixel)
+    @param[out] outW Larghezza dell'uscita (in pixel)
+*/
+void binaryConv2dOutputSize(const BinaryConv2dParams_t* params, uint32_t* outH, uint32_t* outW);
+
+/*!
+    @brief  Restituisce il numero di parole di ogni filtro
+    @details Ogni filtro contiene kH * kW * inC bit in ordine (ky, kx, c), allineati a parole di 32 bit;
+             i filtri sono memorizzati uno dopo l'altro, quindi filters deve contenere outC * filterWords parole.
+    @param[in]  params I parametri della convoluzione
+    @return     Il numero di parole di 32 bit di un filtro
+*/
+uint32_t binaryConv2dFilterWords(const BinaryConv2dParams_t* params);
+
+/*!
+    @brief  Alloca il workspace di binaryConv2d
+    @details Da chiamare una volta in fase di setup: lo stesso workspace puo' essere riusato da tutte le convoluzioni
+             con filterWords non superiore a quello dei parametri passati. Chiamate concorrenti (ad esempio sui due
+             core) richiedono workspace distinti.
+    @param[out] ws Il workspace da allocare
+    @param[in]  params I parametri della convoluzione piu' grande da eseguire
+    @return     true se l'allocazione e' andata a buon fine, false altrimenti
+*/
+bool binaryConv2dAllocWorkspace(BinaryConv2dWorkspace_t* ws, const BinaryConv2dParams_t* params);
+
+/// Libera il workspace allocato con binaryConv2dAllocWorkspace
+void binaryConv2dFreeWorkspace(BinaryConv2dWorkspace_t* ws);
+
+/*!
+    @brief      Esegue una convoluzione 2D binaria con binarizzazione e max-pool opzionale
+    @details    Il prodotto viene calcolato a tile di 32 pixel di uscita x 32 canali di uscita accumulando lo XNOR-popcount
+                con binaryBlockMatrixMul. Le posizioni della finestra che cadono nel padding (o nella coda dell'ultima
+                parola del filtro) non contribuiscono: il numero di match spuri viene tolto con un AND-popcount tra i bit
+                mascherati e i bit nulli del filtro, e ogni bit di padding vale mezzo match, cioe' contributo nullo nel
+                prodotto +-1. Il bit di uscita vale 1 se 2 * match + bitPadding > 2 * signCmp, ovvero signCmp e' riferito
+                a 32 * filterWords bit come in fastBinaryMatrixMul.
+                Con poolSize > 1 l'uscita binarizzata viene ridotta con un OR bitwise su finestre poolSize x poolSize
+                non sovrapposte direttamente nella feature map di uscita.
+                Le parole im2col di una riga di 32 pixel vengono costruite una sola volta nel workspace e riusate per
+                tutti i blocchi di canali di uscita.
+    @param[in]  input La feature map di ingresso (inH x inW x inC bit)
+    @param[in]  filters I filtri (outC x filterWords parole)
+    @param[out] output La feature map di uscita (outH x outW x outC bit)
+    @param      signCmp Il valore di confronto per il segno
+    @param[in]  params I parametri della convoluzione
+    @param      ws Il workspace, con ws->filterWords >= binaryConv2dFilterWords(params)
+*/
+void binaryConv2d(const BinaryMatrix_t input, const BinaryMatrix_t filters, BinaryMatrix_t output, uint32_t signCmp, const BinaryConv2dParams_t* params, BinaryConv2dWorkspace_t* ws);
+
+#endif // __BINARY_CONV2D_H__
@@ -0,0 +1,97 @@
+/*!
+    @file       BinaryHammingSearch.h
+    @brief      Ricerca dei vicini piu' prossimi per distanza di Hamming su vettori bit-packed.
+    @details    La distanza di Hamming tra due parole e' 32 - binaryMul: il database e' memorizzato nel layout a
+                frammenti della libreria e interrogato a forza bruta con early-abandon rispetto al k-esimo migliore
+                corrente, oppure tramite un indice multi-index hashing (MIH) che evita la scansione completa.
+                In entrambi i casi i risultati sono ordinati per (distanza, indice) crescenti, quindi coincidono.
+
+    @author     Alan Masutti  (@alanmasu)
+    @date       18/10/2026
+*/
+
+#ifndef __BINARY_HAMMING_SEARCH_H__
+#define __BINARY_HAMMING_SEARCH_H__
+
+#include <BinaryMatMul.h>
+
+#define HAMMING_TOPK_MAX            16  ///< Numero massimo di vicini restituiti per query
+#define HAMMING_MIH_SUBSTRING_BITS  16  ///< Lunghezza delle sottostringhe dell'indice MIH (in bit)
+
+#ifndef HAMMING_MIH_MAX_RADIUS
+#define HAMMING_MIH_MAX_RADIUS      3   ///< Raggio massimo sulle sottostringhe prima di passare alla forza bruta
+#endif
+
+typedef struct HammingDatabase_t {
+    BinaryFragment_t* frags;    ///< frags[blk * (dim / 32) + i][r] e' la parola i del vettore blk * 32 + r
+    uint32_t          count;    ///< Numero di vettori
+    uint32_t          dim;      ///< Dimensione dei vettori (in bit, multiplo di 32)
+} HammingDatabase_t;
+
+typedef struct HammingIndex_t {
+    const HammingDatabase_t* db;            ///< Database indicizzato
+    uint32_t                 substrings;    ///< Numero di sottostringhe (dim / HAMMING_MIH_SUBSTRING_BITS)
+    uint16_t*                keys;          ///< Per ogni sottostringa, count chiavi ordinate
+    uint32_t*                ids;           ///< Per ogni sottostringa, gli indici dei vettori nello stesso ordine di keys
+    uint32_t*                visited;       ///< Bitmap dei vettori gia' valutati durante una query
+} HammingIndex_t;
+
+/*!
+    @brief  Carica un insieme di vettori nel layout a frammenti del database
+    @details Se count non e' multiplo di 32 l'ultimo blocco viene completato con vettori nulli, mai restituiti.
+    @param[out] db Il database da inizializzare
+    @param[in]  vectors I vettori, uno per riga (count x dim bit)
+    @param      count Numero di vettori
+    @param      dim Dimensione dei vettori (in bit, multiplo di 32)
+    @return     true se l'allocazione e' andata a buon fine, false altrimenti
+*/
+bool hammingDatabaseLoad(HammingDatabase_t* db, const BinaryMatrix_t vectors, uint32_t count, uint32_t dim);
+
+/// Libera i frammenti allocati con hammingDatabaseLoad
+void hammingDatabaseFree(HammingDatabase_t* db);
+
+/*!
+    @brief  Cerca i topK vicini piu' prossimi di un batch di query a forza bruta
+    @details Il database viene scandito un blocco di 32 vettori alla volta per tutte le query del batch; la distanza
+             di ogni vettore viene accumulata parola per parola e abbandonata appena non puo' piu' entrare nei topK.
+    @param[in]  db Il database
+    @param[in]  queries Le query, una per riga (qCount x dim bit)
+    @param      qCount Numero di query
+    @param      topK Numero di vicini per query (1..HAMMING_TOPK_MAX, non oltre db->count)
+    @param[out] indices Indici dei vicini (qCount x topK), per distanza crescente
+    @param[out] distances Distanze dei vicini (qCount x topK)
+    @return     true se la ricerca e' stata eseguita, false se topK non e' valido
+*/
+bool hammingKnnSearch(const HammingDatabase_t* db, const BinaryMatrix_t queries, uint32_t qCount, uint32_t topK, uint32_t* indices, uint32_t* distances);
+
+/*!
+    @brief  Costruisce l'indice multi-index hashing del database
+    @details Ogni vettore viene diviso in dim / 16 sottostringhe; per ognuna viene creata una tabella di coppie
+             (chiave, indice) ordinate per chiave. Occupa circa 6 * count * dim / 16 byte.
+    @param[out] index L'indice da costruire
+    @param[in]  db Il database (deve restare valido finche' l'indice e' in uso)
+    @return     true se la costruzione e' andata a buon fine, false altrimenti
+*/
+bool hammingIndexBuild(HammingIndex_t* index, const HammingDatabase_t* db);
+
+/// Libera le tabelle allocate con hammingIndexBuild
+void hammingIndexFree(HammingIndex_t* index);
+
+/*!
+    @brief  Cerca i topK vicini piu' prossimi di un batch di query tramite l'indice MIH
+    @details Le sottostringhe vengono sondate con raggio crescente r: dopo il raggio r sono stati trovati tutti i
+             vettori a distanza minore di substrings * (r + 1), quindi la ricerca termina appena il k-esimo migliore
+             scende sotto questa soglia. Oltre HAMMING_MIH_MAX_RADIUS i vettori non ancora valutati vengono scanditi
+             a forza bruta con early-abandon. La ricerca usa la bitmap visited dell'indice, quindi l'indice viene
+             modificato: ricerche concorrenti richiedono un indice per ogni chiamante.
+    @param      index L'indice
+    @param[in]  queries Le query, una per riga (qCount x dim bit)
+    @param      qCount Numero di query
+    @param      topK Numero di vicini per query (1..HAMMING_TOPK_MAX, non oltre db->count)
+    @param[out] indices Indici dei vicini (qCount x topK), per distanza crescente
+    @param[out] distances Distanze dei vicini (qCount x topK)
+    @return     true se la ricerca e' stata eseguita, false se topK non e' valido
+*/
+bool hammingIndexSearch(HammingIndex_t* index, const BinaryMatrix_t queries, uint32_t qCount, uint32_t topK, uint32_t* indices, uint32_t* distances);
+
+#endif // __BINARY_HAMMING_SEARCH_H__
@@ -0,0 +1,128 @@
+/*!
+    @file       BinaryLowBitMatMul.h
+    @brief      Moltiplicazione di matrici quantizzate a 2/4 bit tramite decomposizione in bit-plane.
+    @details    Ogni operando viene scomposto in bit-plane, ciascuno memorizzato come BinaryMatrix_t bit-packed.
+                I prodotti tra coppie di plane vengono calcolati con i kernel a blocchi della libreria
+                (AND-popcount o XNOR-popcount, a seconda della codifica) e ricombinati con degli shift.
+
+    @author     Alan Masutti  (@alanmasu)
+    @date       18/10/2026
+*/
+
+#ifndef __BINARY_LOWBIT_MATMUL_H__
+#define __BINARY_LOWBIT_MATMUL_H__
+
+#include <BinaryMatMul.h>
+
+#define BINARY_MAX_PLANES 4 ///< Numero massimo di bit-plane per operando
+
+typedef enum BitPlaneEncoding_t {
+    BITPLANE_UNSIGNED = 0,  ///< x = sum_p 2^p * b_p, con b_p in {0, 1} (AND-popcount)
+    BITPLANE_BIPOLAR  = 1   ///< x = sum_p 2^p * (2 * b_p - 1), valori dispari in [-(2^bits - 1), 2^bits - 1] (XNOR-popcount)
+} BitPlaneEncoding_t;
+
+typedef struct BitPlaneMatrix_t {
+    BinaryMatrix_t     planes[BINARY_MAX_PLANES];   ///< planes[p] contiene il bit p di ogni elemento (rows x cols bit)
+    uint8_t            bits;                        ///< Numero di bit-plane utilizzati
+    BitPlaneEncoding_t encoding;                    ///< Codifica dei valori
+    uint32_t           rows;                        ///< Numero di righe (in bit)
+    uint32_t           cols;                        ///< Numero di colonne (in bit)
+} BitPlaneMatrix_t;
+
+typedef int32_t* IntMatrix_t;
+
+/*!
+    @brief  Alloca i bit-plane di una matrice quantizzata
+    @details I plane vengono allocati con calloc, ognuno come una matrice binaria di dimensioni rows x cols (in bit).
+    @param[out] mat La matrice da inizializzare
+    @param      rows Numero di righe della matrice (in bit)
+    @param      cols Numero di colonne della matrice (in bit)
+    @param      bits Numero di bit per elemento (1..BINARY_MAX_PLANES)
+    @param      encoding La codifica dei valori
+    @return     true se l'allocazione e' andata a buon fine, false altrimenti
+*/
+bool allocBitPlaneMatrix(BitPlaneMatrix_t* mat, uint32_t rows, uint32_t cols, uint8_t bits, BitPlaneEncoding_t encoding);
+
+/// Libera i bit-plane allocati con allocBitPlaneMatrix
+void freeBitPlaneMatrix(BitPlaneMatrix_t* mat);
+
+/*!
+    @brief  Converte un codice quantizzato nel valore intero che rappresenta
+    @param  code Il codice (0..2^bits - 1)
+    @param  bits Numero di bit per elemento
+    @param  encoding La codifica dei valori
+    @return Il valore rappresentato dal codice
+*/
+int32_t bitPlaneCodeToValue(uint8_t code, uint8_t bits, BitPlaneEncoding_t encoding);
+
+/*!
+    @brief  Scompone una matrice di codici quantizzati in bit-plane
+    @details Il bit p del codice di ogni elemento viene scritto nel plane p.
+    @param[in]  codes I codici, un byte per elemento, in row-major (rows x cols)
+    @param[out] mat La matrice a bit-plane (gia' allocata)
+*/
+void packBitPlanes(const uint8_t* codes, BitPlaneMatrix_t* mat);
+
+/*!
+    @brief  Ricompone i codici quantizzati a partire dai bit-plane
+    @param[in]  mat La matrice a bit-plane
+    @param[out] codes I codici, un byte per elemento, in row-major (rows x cols)
+*/
+void unpackBitPlanes(const BitPlaneMatrix_t* mat, uint8_t* codes);
+
+/*!
+    @brief  Binarizza una matrice su piu' livelli scrivendo direttamente i bit-plane
+    @details Generalizza binarizeMatrix: il codice di ogni elemento e' (mat[i] - offset) / step,
+             saturato nell'intervallo [0, 2^bits - 1].
+    @param[in]  mat La matrice da convertire (rows x cols)
+    @param[out] planes La matrice a bit-plane risultante (gia' allocata)
+    @param      offset Il valore corrispondente al codice 0
+    @param      step L'ampiezza di un livello di quantizzazione (> 0)
+*/
+void binarizeMatrixToBitPlanes(const Matrix_t mat, BitPlaneMatrix_t* planes, uint32_t offset, uint32_t step);
+
+/*!
+    @brief      Moltiplica due matrici quantizzate a bit-plane
+    @details    Calcola result = A * B, con A di dimensioni m x n e B di dimensioni n x k. Per ogni coppia di plane (p, q)
+                viene eseguito un prodotto a blocchi con binaryAndBlockMatrixMul (entrambi gli operandi senza segno o
+                codifiche miste) oppure con binaryBlockMatrixMul (entrambi bipolari), poi il risultato viene corretto
+                in base alla codifica e sommato al tile di uscita con peso 2^(p + q).
+    @param[in]  a La matrice A
+    @param[in]  b La matrice B
+    @param[out] result La matrice risultante (m x k interi con segno)
+*/
+void lowBitMatrixMul(const BitPlaneMatrix_t* a, const BitPlaneMatrix_t* b, IntMatrix_t result);
+
+/*!
+    @brief      Moltiplica due matrici quantizzate a bit-plane binarizzando il risultato
+    @details    Come lowBitMatrixMul, ma il tile di uscita viene confrontato con threshold e
+                memorizzato come matrice binaria tramite storeFragment.
+    @param[in]  a La matrice A
+    @param[in]  b La matrice B
+    @param[out] c La matrice binaria risultante (m x k bit)
+    @param      threshold Il valore di confronto: il bit vale 1 se il prodotto e' maggiore di threshold
+*/
+void fastLowBitMatrixMul(const BitPlaneMatrix_t* a, const BitPlaneMatrix_t* b, BinaryMatrix_t c, int32_t threshold);
+
+/*!
+    @brief      Moltiplica due matrici bipolari a bit-plane sulla BTPU
+    @details    I plane di A vengono caricati nella memoria IO0 e quelli di B nella memoria W una sola volta. Ogni tile
+                di uscita viene calcolato separatamente con job di un solo blocco (mSize = kSize = 1), l'unico caso in
+                cui l'accumulo tra job con ACC_CLEAR a 0 e' definito: ACC_CLEAR viene settato solo sul primo job del
+                tile. Dato che la BTPU restituisce solo l'uscita binarizzata, il peso 2^(p + q) della coppia di plane
+                (p, q) viene ottenuto rilanciando 2^(p + q) volte il job della coppia senza ricaricare i dati.
+                La soglia viene convertita internamente da prodotto intero a conteggio XNOR pesato; se threshold e'
+                minore del prodotto minimo possibile c viene riempita di 1 senza usare la BTPU.
+    @param      dev L'istanza della BTPU (reale o emulata)
+    @param[in]  a La matrice A (codifica BITPLANE_BIPOLAR)
+    @param[in]  b La matrice B (codifica BITPLANE_BIPOLAR)
+    @param[out] c La matrice binaria risultante (m x k bit)
+    @param      threshold Il valore di confronto sul prodotto intero, come in fastLowBitMatrixMul
+    @return     true se la moltiplicazione e' stata completata, false in caso di codifica non supportata,
+                memoria della BTPU insufficiente o errore della BTPU
+    @note       I job per tile sono (2^bitsA - 1) * (2^bitsB - 1), non bitsA * bitsB: 9 per 2x2 bit, 225 per 4x4 bit.
+                Il totale va moltiplicato per il numero di tile (m / 32) * (k / 32).
+*/
+bool lowBitMatrixMulBTPU(const BTPUDevice_t* dev, const BitPlaneMatrix_t* a, const BitPlaneMatrix_t* b, BinaryMatrix_t c, int32_t threshold);
+
+#endif // __BINARY_LOWBIT_MATMUL_H__
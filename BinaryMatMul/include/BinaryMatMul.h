@@ -39,6 +39,14 @@
 
 #define BTPU_MAX_BLOCK_COUNT 1024  ///< Maximum number of blocks for matrix multiplication
 
+#ifndef BINARY_MATMUL_A_PANEL_FRAGS
+#define BINARY_MATMUL_A_PANEL_FRAGS 32   ///< Capacita' del pannello di righe di A (in frammenti): n fino a 1024 bit
+#endif
+
+#ifndef BINARY_MATMUL_B_PANEL_FRAGS
+#define BINARY_MATMUL_B_PANEL_FRAGS 128  ///< Capacita' del pannello di colonne di B trasposto (in frammenti): 16 kB
+#endif
+
 typedef struct BTPUCRegField_t {
     unsigned START : 1;          ///< Bit 0: Start bit
     unsigned BUSY : 1;           ///< Bit 1: Busy bit
@@ -75,12 +83,43 @@ typedef uint32_t* Matrix_t;
 
 typedef uint32_t  BinaryAcc_t[BINARY_FRAG_SIZE][BINARY_FRAG_SIZE];
 
+/*!
+    @brief  Buffer dei pannelli di A e B usati dalle varianti con packing
+    @details Viene fornito dal chiamante (ad esempio statico, o in un banco di SRAM dedicato), cosi' che la libreria
+             non occupi memoria per i pannelli se non vengono usati e che chiamate con workspace diversi (es. una per
+             core) possano essere eseguite in parallelo.
+*/
+typedef struct BinaryPanelWorkspace_t {
+    BinaryFragment_t a[BINARY_MATMUL_A_PANEL_FRAGS];   ///< Pannello della riga di blocchi di A
+    BinaryFragment_t b[BINARY_MATMUL_B_PANEL_FRAGS];   ///< Pannello dei blocchi colonna di B trasposti
+} BinaryPanelWorkspace_t;
+
 typedef void(*BTPUCallBackFunct_t)(void);
 
 extern BinaryFragment_t*   BTPU0_W_MEMORY;
 extern BinaryFragment_t* BTPU0_IO0_MEMORY;
 extern BinaryFragment_t* BTPU0_IO1_MEMORY;
 
+/*!
+    @brief  Descrittore di un'istanza della BTPU
+    @details Contiene solo registri e memorie dell'istanza, quindi una tabella di dispositivi puo' essere const
+             (e risiedere in flash). Un'istanza con emulatorAcc non NULL viene eseguita in software da btpuEmulatorRun.
+*/
+typedef struct BTPUDevice_t {
+    BTPURegFile_t*    regs;         ///< Register file dell'istanza
+    BinaryFragment_t* wMemory;      ///< Memoria W dell'istanza
+    BinaryFragment_t* io0Memory;    ///< Memoria IO0 dell'istanza
+    BinaryFragment_t* io1Memory;    ///< Memoria IO1 dell'istanza
+    BinaryAcc_t*      emulatorAcc;  ///< Accumulatore dell'istanza emulata (NULL per un'istanza reale)
+} BTPUDevice_t;
+
+/// Inizializzatore di un descrittore a partire dagli indirizzi base dell'istanza
+#define BTPU_DEVICE(cregBase, wMemBase, io0MemBase, io1MemBase) \
+    { (BTPURegFile_t*)(cregBase), (BinaryFragment_t*)(wMemBase), (BinaryFragment_t*)(io0MemBase), (BinaryFragment_t*)(io1MemBase), NULL }
+
+/// Descrittore della BTPU0
+#define BTPU0_DEVICE BTPU_DEVICE(BTPU_CREG_BASE, BTPU_W_MEMORY_BASE, BTPU_IO0_MEMORY_BASE, BTPU_IO1_MEMORY_BASE)
+
 /// Legge un bit da una matrice binaria bit-packed
 uint8_t getBit(const BinaryMatrix_t mat, uint32_t row, uint32_t col, uint32_t N);
 
@@ -123,6 +162,16 @@ uint32_t xnor32(const uint32_t a, const uint32_t b);
 */
 uint32_t binaryMul(const uint32_t a, const uint32_t b);
 
+/*!
+    @brief  Moltiplica due parole binarie con codifica {0, 1}
+    @details Prende in ingresso due parole binarie di 32 bit e restituisce il numero di bit
+             settati in entrambe le parole (AND-popcount).
+    @param[in]  a La parola binaria A
+    @param[in]  b La parola binaria B
+    @return     Il numero di bit a 1 in entrambe le parole
+*/
+uint32_t binaryAndMul(const uint32_t a, const uint32_t b);
+
 
 /*!
     @brief  Moltiplica due frammenti di matrice binaria
@@ -134,6 +183,15 @@ uint32_t binaryMul(const uint32_t a, const uint32_t b);
 */
 void binaryBlockMatrixMul(const BinaryFragment_t a, const BinaryFragment_t b, BinaryAcc_t acc);
 
+/*!
+    @brief  Moltiplica due frammenti di matrice binaria con codifica {0, 1}
+    @details Come binaryBlockMatrixMul, ma accumula l'AND-popcount al posto dello XNOR-popcount.
+    @param[in]  a Il frammento A
+    @param[in]  b Il frammento B (trasposto)
+    @param[out] acc L'accumulatore in cui memorizzare il risultato
+*/
+void binaryAndBlockMatrixMul(const BinaryFragment_t a, const BinaryFragment_t b, BinaryAcc_t acc);
+
 /*!
     @brief  Moltiplica due frammenti di matrice binaria applicando il segno
     @details Prende in ingresso due frammenti di matrice binaria di dimensioni BINARY_FRAG_SIZE x BINARY_FRAG_SIZE
@@ -193,25 +251,63 @@ void storeAcc(const BinaryAcc_t acc, Matrix_t mat, uint32_t blockRow, uint32_t b
 */
 void fillAccWithZero(BinaryAcc_t acc);
 
+/*!
+    @brief  Imposta la dimensione predefinita dei pannelli di B usati da binaryMatrixMul e fastBinaryMatrixMul
+    @details Il pannello di B contiene panelBlocks blocchi colonna, caricati e trasposti una sola volta, ed e'
+             limitato dalla capacita' BINARY_MATMUL_B_PANEL_FRAGS di BinaryPanelWorkspace_t. Il valore viene usato dal planner per le forme
+             senza piano misurato o caricato da tabella.
+    @param  panelBlocks Numero di blocchi colonna per pannello (0 per usare il massimo consentito dalla capacita')
+*/
+void binaryMatMulSetPanelBlocks(uint32_t panelBlocks);
+
+/*!
+    @brief  Restituisce la dimensione predefinita del pannello di B per una data forma
+    @param  n Numero di colonne della matrice A e righe della matrice B (in bit)
+    @param  k Numero di colonne della matrice B (in bit)
+    @return Il numero di blocchi colonna per pannello, 0 se i pannelli non entrano nei buffer
+            e viene usato il percorso senza packing
+*/
+uint32_t binaryMatMulGetPanelBlocks(uint32_t n, uint32_t k);
+
 /*!
     @brief      Moltiplica due matrici binarie
     @details    Prende in ingresso due matrici binarie di dimensioni M x N e N x K
                 e restituisce il risultato della moltiplicazione in una matrice di dimensioni m x k.
                 La moltiplicazione viene eseguita in blocchi di dimensione BINARY_FRAG_SIZE x BINARY_FRAG_SIZE.
+                I frammenti di B vengono caricati e trasposti una sola volta in un pannello di colonne, e per ogni
+                pannello i frammenti di una riga di blocchi di A vengono raccolti una sola volta in un pannello di righe.
     @param[in]  a La matrice binaria A
     @param[in]  b La matrice binaria B
     @param[out] result La matrice risultante
     @param      m Numero di righe della matrice A
     @param      n Numero di colonne della matrice A e righe della matrice B
     @param      k Numero di colonne della matrice B
+    @note       La variante del kernel (pannelli, dimensione del pannello) viene scelta tramite il planner
+                (vedi BinaryMatMulPlanner.h). I pannelli vengono usati solo se al planner e' stato fornito un
+                workspace con binaryPlannerSetWorkspace; senza workspace e senza timer la funzione e' rientrante.
 */
 void binaryMatrixMul(const BinaryMatrix_t a, const BinaryMatrix_t b, Matrix_t result, const int m, const int n, const int k);
 
+/*!
+    @brief      Moltiplica due matrici binarie con una dimensione di pannello fissata
+    @details    Come binaryMatrixMul, ma senza passare dal planner. Usa solo i buffer di ws, quindi e' rientrante.
+    @param[in]  a La matrice binaria A
+    @param[in]  b La matrice binaria B
+    @param[out] result La matrice risultante
+    @param      m Numero di righe della matrice A
+    @param      n Numero di colonne della matrice A e righe della matrice B
+    @param      k Numero di colonne della matrice B
+    @param      panelBlocks Blocchi colonna per pannello di B (0 per il percorso senza packing)
+    @param      ws I buffer dei pannelli (NULL per il percorso senza packing), da non condividere tra chiamate concorrenti
+*/
+void binaryMatrixMulPanel(const BinaryMatrix_t a, const BinaryMatrix_t b, Matrix_t result, const int m, const int n, const int k, uint32_t panelBlocks, BinaryPanelWorkspace_t* ws);
+
 /*!
     @brief  Moltiplica due matrici binarie applicando il segno
     @details Prende in ingresso due matrici binarie di dimensioni M x N e N x K
              e restituisce il risultato della moltiplicazione in una matrice di dimensioni m x k,
              calcolando il segno confrontando il risultato con un valore di confronto specificato.
+             Come binaryMatrixMul, la variante del kernel viene scelta tramite il planner.
     @param[in]  a La matrice binaria A
     @param[in]  b La matrice binaria B
     @param[out] c La matrice risultante
@@ -222,6 +318,38 @@ void binaryMatrixMul(const BinaryMatrix_t a, const BinaryMatrix_t b, Matrix_t re
 */
 void fastBinaryMatrixMul(const BinaryMatrix_t a, const BinaryMatrix_t b, BinaryMatrix_t c, uint32_t signCmp, const int m, const int n, const int k);
 
+/*!
+    @brief  Moltiplica due matrici binarie applicando il segno con una dimensione di pannello fissata
+    @details Come fastBinaryMatrixMul, ma senza passare dal planner. Usa solo i buffer di ws, quindi e' rientrante.
+    @param[in]  a La matrice binaria A
+    @param[in]  b La matrice binaria B
+    @param[out] c La matrice risultante
+    @param      signCmp Il valore di confronto per il segno
+    @param      m Numero di righe della matrice A (in bit)
+    @param      n Numero di colonne della matrice A e righe della matrice B (in bit)
+    @param      k Numero di colonne della matrice B (in bit)
+    @param      panelBlocks Blocchi colonna per pannello di B (0 per il percorso senza packing)
+    @param      ws I buffer dei pannelli (NULL per il percorso senza packing), da non condividere tra chiamate concorrenti
+*/
+void fastBinaryMatrixMulPanel(const BinaryMatrix_t a, const BinaryMatrix_t b, BinaryMatrix_t c, uint32_t signCmp, const int m, const int n, const int k, uint32_t panelBlocks, BinaryPanelWorkspace_t* ws);
+
+/*!
+    @brief  Moltiplica due matrici binarie applicando il segno sulla BTPU
+    @details Carica A nella memoria IO0 e B nella memoria W dell'istanza, esegue un job batched e legge il risultato
+             dalla memoria IO1.
+    @param      dev L'istanza della BTPU (reale o emulata)
+    @param[in]  a La matrice binaria A
+    @param[in]  b La matrice binaria B
+    @param[out] c La matrice risultante
+    @param      signCmp Il valore di confronto per il segno
+    @param      m Numero di righe della matrice A (in bit)
+    @param      n Numero di colonne della matrice A e righe della matrice B (in bit)
+    @param      k Numero di colonne della matrice B (in bit)
+    @return true se la moltiplicazione e' stata completata, false se le matrici non entrano nelle memorie della BTPU
+            o in caso di errore della BTPU
+*/
+bool fastBinaryMatrixMulBTPU(const BTPUDevice_t* dev, const BinaryMatrix_t a, const BinaryMatrix_t b, BinaryMatrix_t c, uint32_t signCmp, const int m, const int n, const int k);
+
 /*!
     @brief  Converte una matrice in una matrice binaria
 
@@ -344,4 +472,39 @@ bool btpuWaitBinaryMatrixMul(BTPURegFile_t* inst);
 */
 bool btpuWaitBinaryMatrixMulWithCb(BTPURegFile_t* inst, BTPUCallBackFunct_t funct);
 
+/*!
+    @brief  Avvia un job su un'istanza descritta da un BTPUDevice_t
+    @details Come btpuStartBinaryMatrixMul. Su un'istanza emulata azzera prima ERROR, cosi' che un job fallito
+             non blocchi i successivi, e setta BUSY come farebbe l'hardware all'avvio.
+    @return true se il job e' stato avviato, false se l'istanza e' occupata o in errore
+*/
+bool btpuDeviceStart(const BTPUDevice_t* dev, const uint32_t signCmp, bool isBatched, bool clearAcc, uint8_t outputMemorySelect);
+
+/*!
+    @brief  Controlla senza attendere se il job di un'istanza e' terminato
+    @details Su un'istanza emulata esegue il job in sospeso con btpuEmulatorRun.
+    @return true se l'istanza non e' occupata
+*/
+bool btpuDeviceDone(const BTPUDevice_t* dev);
+
+/*!
+    @brief  Attende il completamento del job di un'istanza
+    @details Da usare al posto di btpuWaitBinaryMatrixMul per le istanze emulate, che altrimenti non terminano mai.
+    @return true se il job e' terminato senza errori, false altrimenti
+*/
+bool btpuDeviceWait(const BTPUDevice_t* dev);
+
+/*!
+    @brief  Esegue in software il job avviato su un'istanza emulata
+    @details Se START e' settato calcola i blocchi di uscita programmati nei registri leggendo I e W dalle memorie
+             dell'istanza (W in layout riga di blocchi, I e O in base a OMEM_SEL), binarizza con signCmp, poi azzera
+             START e BUSY. Con BATCHED_MUL a 0 viene calcolato solo il primo blocco di uscita.
+             L'accumulatore dell'istanza viene azzerato se ACC_CLEAR e' settato, altrimenti il job continua ad
+             accumulare su quello del job precedente: dato che l'hardware espone un solo accumulatore documentato,
+             questo e' consentito solo per job con un unico blocco di uscita. Un job con piu' blocchi e ACC_CLEAR
+             a 0 o con indirizzi fuori dalle memorie setta ERROR.
+    @param  dev L'istanza emulata
+*/
+void btpuEmulatorRun(const BTPUDevice_t* dev);
+
 #endif // __BINARY_MATMUL_H__
@@ -0,0 +1,114 @@
+/*!
+    @file       BinaryMatMulPlanner.h
+    @brief      Planner per la scelta della variante del kernel in base alla forma delle matrici.
+    @details    La variante migliore (percorso senza packing, dimensione del pannello, BTPU) dipende da m, n, k e
+                dalla piattaforma. Alla prima chiamata con una nuova forma il planner misura le varianti candidate
+                con il timer impostato, oppure usa una tabella generata offline, e memorizza il piano scelto in una
+                cache indicizzata dalla forma: le chiamate successive non hanno alcun costo di tuning. La cache ha
+                capacita' fissa e nessuna politica di rimpiazzo: una volta piena, le forme nuove usano il piano
+                predefinito senza tuning.
+                Le sole dimensioni misurate sono la dimensione del pannello (o l'assenza di packing) e la scelta tra
+                CPU e BTPU: backend del popcount, micro-tile e numero di core non fanno parte del piano.
+
+    @author     Alan Masutti  (@alanmasu)
+    @date       18/10/2026
+*/
+
+#ifndef __BINARY_MATMUL_PLANNER_H__
+#define __BINARY_MATMUL_PLANNER_H__
+
+#include <BinaryMatMul.h>
+
+#ifndef BINARY_PLANNER_CACHE_SIZE
+#define BINARY_PLANNER_CACHE_SIZE 16    ///< Numero di piani memorizzati nella cache (capacita' fissa, senza rimpiazzo)
+#endif
+
+typedef enum BinaryMatMulKernel_t {
+    BINARY_KERNEL_UNPACKED = 0,     ///< Ciclo blockRow, blockCol, i senza packing
+    BINARY_KERNEL_PANEL    = 1,     ///< Pannelli di A e B impacchettati (panelBlocks blocchi colonna)
+    BINARY_KERNEL_BTPU     = 2      ///< Job batched sulla BTPU (solo risultato binarizzato)
+} BinaryMatMulKernel_t;
+
+typedef struct BinaryMatMulPlan_t {
+    uint32_t             m;             ///< Numero di righe della matrice A (in bit)
+    uint32_t             n;             ///< Numero di colonne della matrice A e righe della matrice B (in bit)
+    uint32_t             k;             ///< Numero di colonne della matrice B (in bit)
+    bool                 binarized;     ///< true per fastBinaryMatrixMul, false per binaryMatrixMul
+    BinaryMatMulKernel_t kernel;        ///< Variante del kernel scelta
+    uint32_t             panelBlocks;   ///< Blocchi colonna per pannello (solo BINARY_KERNEL_PANEL)
+} BinaryMatMulPlan_t;
+
+/// Timer usato per misurare le varianti, deve restituire il tempo in microsecondi
+typedef uint64_t(*BinaryPlannerTimer_t)(void);
+
+/*!
+    @brief  Imposta il timer usato per il tuning
+    @details Senza timer (NULL) le forme non presenti in tabella usano il piano predefinito: pannelli della
+             dimensione impostata con binaryMatMulSetPanelBlocks se e' impostato un workspace, altrimenti il
+             percorso senza packing. Il tuning scrive nella cache dei piani, condivisa da tutte le chiamate.
+    @param  timer La funzione che restituisce il tempo in microsecondi (es. time_us_64 del Pico SDK)
+*/
+void binaryPlannerSetTimer(BinaryPlannerTimer_t timer);
+
+/*!
+    @brief  Imposta i buffer dei pannelli usati dalle varianti con packing
+    @details Senza workspace (NULL, il default) il planner usa solo il percorso senza packing e binaryMatrixMul /
+             fastBinaryMatrixMul restano rientranti. Il workspace e' condiviso da tutte le chiamate che passano dal
+             planner: se impostato, non vanno eseguite in parallelo (es. dai due core o da un'ISR).
+    @param  ws I buffer dei pannelli (devono restare validi), NULL per disabilitare i pannelli
+*/
+void binaryPlannerSetWorkspace(BinaryPanelWorkspace_t* ws);
+
+/*!
+    @brief  Abilita la BTPU come variante candidata per fastBinaryMatrixMul
+    @param  dev L'istanza della BTPU (deve restare valida), NULL per disabilitarla
+*/
+void binaryPlannerSetBTPU(const BTPUDevice_t* dev);
+
+/*!
+    @brief  Imposta una tabella di piani generata offline
+    @details La tabella viene consultata prima della cache e non viene copiata: deve restare valida.
+    @param  table L'array di piani
+    @param  count Numero di piani nella tabella
+*/
+void binaryPlannerLoadTable(const BinaryMatMulPlan_t* table, uint32_t count);
+
+/// Svuota la cache dei piani misurati
+void binaryPlannerClearCache(void);
+
+/*!
+    @brief  Cerca il piano per una forma senza eseguire il tuning
+    @param  m Numero di righe della matrice A (in bit)
+    @param  n Numero di colonne della matrice A e righe della matrice B (in bit)
+    @param  k Numero di colonne della matrice B (in bit)
+    @param  binarized true per fastBinaryMatrixMul, false per binaryMatrixMul
+    @return Il piano in tabella o in cache, NULL se la forma non e' ancora stata pianificata
+*/
+const BinaryMatMulPlan_t* binaryPlannerGetPlan(uint32_t m, uint32_t n, uint32_t k, bool binarized);
+
+/*!
+    @brief  Copia i piani in cache in una tabella
+    @details Utile per generare offline la tabella da passare a binaryPlannerLoadTable.
+    @param[out] table L'array di destinazione
+    @param      maxCount Numero massimo di piani da copiare
+    @return     Numero di piani copiati
+*/
+uint32_t binaryPlannerExportTable(BinaryMatMulPlan_t* table, uint32_t maxCount);
+
+/*!
+    @brief  Moltiplica due matrici binarie con il piano scelto per la forma
+    @details Alla prima chiamata con una forma non in tabella, se e' impostato un timer, tutte le varianti candidate
+             vengono eseguite sugli operandi reali (il risultato e' quindi gia' corretto) e la piu' veloce viene
+             memorizzata in cache. Se la cache contiene gia' BINARY_PLANNER_CACHE_SIZE piani la forma usa il piano
+             predefinito, senza tuning e senza essere memorizzata: per carichi con piu' forme va aumentata la
+             capacita' o caricata una tabella con binaryPlannerLoadTable. Usata da binaryMatrixMul.
+*/
+void binaryPlannerMatrixMul(const BinaryMatrix_t a, const BinaryMatrix_t b, Matrix_t result, const int m, const int n, const int k);
+
+/*!
+    @brief  Moltiplica due matrici binarie applicando il segno con il piano scelto per la forma
+    @details Come binaryPlannerMatrixMul; tra i candidati c'e' anche la BTPU se abilitata. Usata da fastBinaryMatrixMul.
+*/
+void fastBinaryPlannerMatrixMul(const BinaryMatrix_t a, const BinaryMatrix_t b, BinaryMatrix_t c, uint32_t signCmp, const int m, const int n, const int k);
+
+#endif // __BINARY_MATMUL_PLANNER_H__
@@ -0,0 +1,60 @@
+/*!
+    @file       BinarySemiringMatMul.h
+    @brief      Moltiplicazione di matrici binarie nei semianelli GF(2) (XOR/AND) e booleano (OR/AND).
+    @details    Usa lo stesso layout bit-packed di BinaryMatrix_t e dei frammenti. Il calcolo segue il Method of Four
+                Russians: per ogni blocco di B (32 righe x 32 colonne) vengono precalcolate quattro tabelle da 256
+                parole con tutte le combinazioni di 8 righe consecutive (4 KB in totale), poi ogni parola di A
+                seleziona con i suoi quattro byte una voce per tabella. Il lavoro scende da O(m n k) a
+                O(m n k / 8) operazioni su bit, piu' il costo delle tabelle ammortizzato sulle m righe di A.
+                Le tabelle sono in un workspace fornito dal chiamante, come i pannelli di BinaryPanelWorkspace_t.
+
+    @author     Alan Masutti  (@alanmasu)
+    @date       18/10/2026
+*/
+
+#ifndef __BINARY_SEMIRING_MATMUL_H__
+#define __BINARY_SEMIRING_MATMUL_H__
+
+#include <BinaryMatMul.h>
+
+#define BINARY_M4R_CHUNK_BITS   8                               ///< Righe di B combinate in una tabella
+#define BINARY_M4R_TABLE_SIZE   (1 << BINARY_M4R_CHUNK_BITS)    ///< Voci di una tabella
+#define BINARY_M4R_TABLES       (32 / BINARY_M4R_CHUNK_BITS)    ///< Tabelle per parola di A
+
+typedef enum BinarySemiring_t {
+    BINARY_SEMIRING_GF2,        ///< Somma XOR, prodotto AND (parita', codici lineari)
+    BINARY_SEMIRING_BOOLEAN     ///< Somma OR, prodotto AND (raggiungibilita')
+} BinarySemiring_t;
+
+/*!
+    @brief  Tabelle delle combinazioni delle righe del blocco di B corrente (4 KB)
+    @details Viene fornito dal chiamante (ad esempio statico, o nello stack del task), cosi' che chiamate con
+             workspace diversi (es. una per core) possano essere eseguite in parallelo.
+*/
+typedef struct BinaryM4RWorkspace_t {
+    uint32_t tables[BINARY_M4R_TABLES][BINARY_M4R_TABLE_SIZE];  ///< tables[t][idx]: combinazione delle righe 8t..8t+7
+} BinaryM4RWorkspace_t;
+
+/*!
+    @brief      Moltiplica due matrici binarie nel semianello indicato
+    @details    Il bit j del byte b di una parola di A (MSB per primo) seleziona la riga 8b + j del blocco di B.
+                Ogni frammento di C viene accumulato con loadFragment/storeFragment, quindi C ha lo stesso layout
+                delle uscite di fastBinaryMatrixMul.
+    @param[in]  a La matrice binaria A (m x n bit)
+    @param[in]  b La matrice binaria B (n x k bit)
+    @param[out] c La matrice binaria risultante (m x k bit)
+    @param      semiring Il semianello da utilizzare
+    @param      m Numero di righe della matrice A (in bit)
+    @param      n Numero di colonne della matrice A e righe della matrice B (in bit)
+    @param      k Numero di colonne della matrice B (in bit)
+    @param      ws Le tabelle di lavoro, da non condividere tra chiamate concorrenti
+*/
+void binarySemiringMatrixMul(const BinaryMatrix_t a, const BinaryMatrix_t b, BinaryMatrix_t c, BinarySemiring_t semiring, const int m, const int n, const int k, BinaryM4RWorkspace_t* ws);
+
+/// Moltiplica due matrici binarie in GF(2): c = a * b con somma XOR
+void gf2MatrixMul(const BinaryMatrix_t a, const BinaryMatrix_t b, BinaryMatrix_t c, const int m, const int n, const int k, BinaryM4RWorkspace_t* ws);
+
+/// Moltiplica due matrici binarie nel semianello booleano: c = a * b con somma OR
+void booleanMatrixMul(const BinaryMatrix_t a, const BinaryMatrix_t b, BinaryMatrix_t c, const int m, const int n, const int k, BinaryM4RWorkspace_t* ws);
+
+#endif // __BINARY_SEMIRING_MATMUL_H__
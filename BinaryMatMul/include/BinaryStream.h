@@ -0,0 +1,80 @@
+/*!
+    @file       BinaryStream.h
+    @brief      Inferenza in streaming su strisce di 32 righe con pesi residenti.
+    @details    Le righe di input arrivano a strisce di BINARY_FRAG_SIZE righe (ad esempio da un sensore): ogni striscia
+                attraversa tutti i layer della pipeline appena viene ricevuta e l'uscita dell'ultimo layer viene
+                consegnata a una callback. Ogni layer possiede un solo buffer di striscia, quindi la memoria delle
+                attivazioni e' O(striscia) per layer invece di O(m) e la latenza di una striscia e' limitata dal costo
+                di una moltiplicazione di 32 righe per layer.
+
+    @author     Alan Masutti  (@alanmasu)
+    @date       18/10/2026
+*/
+
+#ifndef __BINARY_STREAM_H__
+#define __BINARY_STREAM_H__
+
+#include <BinaryMatMul.h>
+#include <BinaryBatchedMatMul.h>
+
+#define BINARY_STREAM_MAX_LAYERS 8  ///< Numero massimo di layer di una pipeline
+
+/*!
+    @brief  Callback che riceve una striscia di uscita
+    @param  strip La striscia: BINARY_FRAG_SIZE x k bit (binarizzata) o BINARY_FRAG_SIZE x k valori (raw),
+                  valida solo durante la chiamata
+    @param  rows Numero di righe valide della striscia
+    @param  ctx Il contesto passato a binaryStreamInit
+*/
+typedef void(*BinaryStreamCallback_t)(const uint32_t* strip, uint32_t rows, void* ctx);
+
+typedef struct BinaryStreamLayer_t {
+    const BinaryWeights_t* w;       ///< Pesi preparati del layer (residenti per tutto lo stream)
+    uint32_t               signCmp; ///< Valore di confronto per il segno
+    bool                   raw;     ///< Se true l'uscita non viene binarizzata (solo per l'ultimo layer)
+    uint32_t*              strip;   ///< Buffer della striscia di uscita del layer
+} BinaryStreamLayer_t;
+
+typedef struct BinaryStream_t {
+    BinaryStreamLayer_t    layers[BINARY_STREAM_MAX_LAYERS];   ///< Layer della pipeline, in ordine
+    uint32_t               layerCount;                         ///< Numero di layer
+    BinaryStreamCallback_t callback;                           ///< Callback delle strisce di uscita
+    void*                  ctx;                                ///< Contesto della callback
+    uint32_t               strips;                             ///< Strisce elaborate
+} BinaryStream_t;
+
+/*!
+    @brief  Inizializza una pipeline vuota
+    @param[out] stream La pipeline
+    @param      callback Callback chiamata per ogni striscia di uscita
+    @param      ctx Contesto passato alla callback
+*/
+void binaryStreamInit(BinaryStream_t* stream, BinaryStreamCallback_t callback, void* ctx);
+
+/*!
+    @brief  Aggiunge un layer in coda alla pipeline
+    @details Alloca il buffer di striscia del layer. L'ingresso del layer e' l'uscita del precedente, quindi w->n
+             deve coincidere con il k del layer precedente; un layer raw deve essere l'ultimo.
+    @param  stream La pipeline
+    @param  w I pesi preparati del layer (devono restare validi finche' la pipeline e' in uso)
+    @param  signCmp Il valore di confronto per il segno (ignorato se raw)
+    @param  raw Se true l'uscita del layer e' la matrice dei conteggi XNOR-popcount
+    @return true se il layer e' stato aggiunto, false se non e' compatibile o l'allocazione fallisce
+*/
+bool binaryStreamAddLayer(BinaryStream_t* stream, const BinaryWeights_t* w, uint32_t signCmp, bool raw);
+
+/*!
+    @brief  Elabora una striscia di input
+    @details La striscia attraversa tutti i layer e l'uscita dell'ultimo viene passata alla callback prima del ritorno.
+             Le righe oltre rows vengono comunque calcolate ma non hanno significato.
+    @param  stream La pipeline
+    @param[in] strip La striscia di input: buffer di BINARY_FRAG_SIZE righe da n bit, di cui le prime rows valide
+    @param  rows Numero di righe valide (1..BINARY_FRAG_SIZE)
+    @return true se la striscia e' stata elaborata, false se la pipeline e' vuota o rows non e' valido
+*/
+bool binaryStreamPush(BinaryStream_t* stream, const BinaryMatrix_t strip, uint32_t rows);
+
+/// Libera i buffer di striscia dei layer
+void binaryStreamFree(BinaryStream_t* stream);
+
+#endif // __BINARY_STREAM_H__
@@ -0,0 +1,144 @@
+#include <BinaryBTPUScheduler.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+
+bool btpuSchedulerInit(BTPUScheduler_t* sched, const BTPUDevice_t* devices, uint32_t count){
+    if(count > BTPU_SCHEDULER_MAX_DEVICES){
+        return false;
+    }
+    sched->devices = devices;
+    sched->count = count;
+    for(int d = 0; d < count; ++d){
+        sched->state[d].residentWeights = NULL;
+        sched->state[d].residentN = 0;
+        sched->state[d].residentK = 0;
+        sched->state[d].residentPanelCols = 0;
+        sched->state[d].jobBlockRow = -1;
+        sched->state[d].jobBlockRows = 0;
+        sched->state[d].jobBlockCol = 0;
+        sched->state[d].jobBlockCols = 0;
+        sched->state[d].completedJobs = 0;
+    }
+    return true;
+}
+
+void btpuSchedulerInvalidateWeights(BTPUScheduler_t* sched){
+    for(int d = 0; d < sched->count; ++d){
+        sched->state[d].residentWeights = NULL;
+    }
+}
+
+/*
+    Carica B nella memoria W dell'istanza se non e' gia' residente con lo stesso layout. B viene memorizzata per
+    pannelli di panelCols blocchi colonna: il pannello che parte dal blocco colonna col occupa gli indirizzi da
+    col * blockN, con passo pari alla sua larghezza, come richiesto da un job con kSize = larghezza del pannello.
+    Con panelCols = blockK il layout coincide con quello di loadBinaryMatrixToFragments.
+*/
+static void ensureWeights(const BTPUDevice_t* dev, BTPUDeviceState_t* state, const BinaryMatrix_t b, uint32_t n, uint32_t k, uint32_t panelCols){
+    if(state->residentWeights == b && state->residentN == n && state->residentK == k && state->residentPanelCols == panelCols){
+        return;
+    }
+    const uint32_t blockN = n / BINARY_FRAG_SIZE;
+    const uint32_t blockK = k / BINARY_FRAG_SIZE;
+    for(uint32_t col0 = 0; col0 < blockK; col0 += panelCols){
+        const uint32_t cols = blockK - col0 < panelCols ? blockK - col0 : panelCols;
+        for(int i = 0; i < blockN; ++i){
+            for(int j = 0; j < cols; ++j){
+                loadFragment(dev->wMemory[col0 * blockN + i * cols + j], b, i, col0 + j, k);
+            }
+        }
+    }
+    state->residentWeights = b;
+    state->residentN = n;
+    state->residentK = k;
+    state->residentPanelCols = panelCols;
+}
+
+bool btpuSchedulerMatrixMul(BTPUScheduler_t* sched, const BinaryMatrix_t a, const BinaryMatrix_t b, BinaryMatrix_t c, uint32_t signCmp, const int m, const int n, const int k){
+    const uint32_t blockM = m / BINARY_FRAG_SIZE;
+    const uint32_t blockN = n / BINARY_FRAG_SIZE;
+    const uint32_t blockK = k / BINARY_FRAG_SIZE;
+    if(sched->count == 0 || blockN * blockK > BTPU_MAX_BLOCK_COUNT || blockN + blockK > BTPU_MAX_BLOCK_COUNT){
+        return false;
+    }
+    const uint32_t jobs = sched->count * BTPU_SCHEDULER_JOBS_PER_DEVICE;
+    uint32_t jobRows;
+    uint32_t jobCols;
+    if(blockM >= sched->count){
+        // Abbastanza righe di blocchi per tutte le istanze: job di righe intere
+        jobRows = (blockM + jobs - 1) / jobs;
+        jobCols = blockK;
+    }else{
+        // Poche righe di blocchi (es. strisce da 32 righe): ogni riga viene divisa anche per blocchi colonna
+        const uint32_t colJobs = (jobs + blockM - 1) / blockM;
+        jobRows = 1;
+        jobCols = (blockK + colJobs - 1) / colJobs;
+    }
+    // Ingresso e uscita di un job condividono lo spazio indirizzi: l'uscita segue l'ingresso
+    const uint32_t maxRows = BTPU_MAX_BLOCK_COUNT / (blockN + jobCols);
+    jobRows = jobRows > maxRows ? maxRows : jobRows;
+
+    uint32_t nextRow = 0;
+    uint32_t nextCol = 0;
+    uint32_t running = 0;
+    bool ok = true;
+    while(nextRow < blockM || running > 0){
+        for(int d = 0; d < sched->count; ++d){
+            const BTPUDevice_t* dev = &sched->devices[d];
+            BTPUDeviceState_t* state = &sched->state[d];
+            if(state->jobBlockRow >= 0){
+                if(!btpuDeviceDone(dev)){
+                    continue;
+                }
+                // Raccoglie l'uscita del job terminato
+                const BinaryFragment_t* out = dev->io1Memory + state->jobBlockRows * blockN;
+                if(dev->regs->creg.reg.ERROR){
+                    ok = false;
+                }else{
+                    for(int r = 0; r < state->jobBlockRows; ++r){
+                        for(int j = 0; j < state->jobBlockCols; ++j){
+                            storeFragment(out[r * state->jobBlockCols + j], c, state->jobBlockRow + r, state->jobBlockCol + j, k);
+                        }
+                    }
+                }
+                state->jobBlockRow = -1;
+                state->completedJobs++;
+                --running;
+            }
+            if(nextRow >= blockM || !ok){
+                continue;
+            }
+            // Assegna il prossimo job all'istanza libera
+            const uint32_t rows = blockM - nextRow < jobRows ? blockM - nextRow : jobRows;
+            const uint32_t cols = blockK - nextCol < jobCols ? blockK - nextCol : jobCols;
+            ensureWeights(dev, state, b, n, k, jobCols);
+            for(int r = 0; r < rows; ++r){
+                for(int i = 0; i < blockN; ++i){
+                    loadFragment(dev->io0Memory[r * blockN + i], a, nextRow + r, i, n);
+                }
+            }
+            btpuSetBlocks(dev->regs, rows, blockN, cols);
+            btpuSetAddrs(dev->regs, nextCol * blockN, 0, rows * blockN);
+            if(!btpuDeviceStart(dev, signCmp, true, true, BTPU_USE_MEMORY_0_CONFIG)){
+                ok = false;
+                continue;
+            }
+            state->jobBlockRow = nextRow;
+            state->jobBlockRows = rows;
+            state->jobBlockCol = nextCol;
+            state->jobBlockCols = cols;
+            nextCol += cols;
+            if(nextCol >= blockK){
+                nextCol = 0;
+                nextRow += rows;
+            }
+            ++running;
+        }
+        if(!ok && running == 0){
+            break;
+        }
+    }
+    return ok;
+}
@@ -0,0 +1,122 @@
+#include <BinaryBatchedMatMul.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+
+bool prepareBinaryWeights(BinaryWeights_t* w, const BinaryMatrix_t b, uint32_t n, uint32_t k){
+    const uint32_t blockN = n / BINARY_FRAG_SIZE;
+    const uint32_t blockK = k / BINARY_FRAG_SIZE;
+    BinaryFragment_t b_frag;
+    w->n = n;
+    w->k = k;
+    w->frags = (BinaryFragment_t*)malloc(blockN * blockK * sizeof(BinaryFragment_t));
+    if(!w->frags){
+        return false;
+    }
+    for(int blockCol = 0; blockCol < blockK; ++blockCol){
+        for(int i = 0; i < blockN; ++i){
+            loadFragment(b_frag, b, i, blockCol, k);
+            transposeBinaryFragment(b_frag, w->frags[blockCol * blockN + i]);
+        }
+    }
+    return true;
+}
+
+void freeBinaryWeights(BinaryWeights_t* w){
+    free(w->frags);
+    w->frags = NULL;
+}
+
+static void preparedTileMul(const BinaryMatrix_t a, const BinaryWeights_t* w, Matrix_t result, uint32_t blockRow, uint32_t blockCol){
+    const uint32_t blockN = w->n / BINARY_FRAG_SIZE;
+    const BinaryFragment_t* b_panel = w->frags + blockCol * blockN;
+    BinaryFragment_t a_frag;
+    BinaryAcc_t acc;
+    fillAccWithZero(acc);
+    for(int i = 0; i < blockN; ++i){
+        loadFragment(a_frag, a, blockRow, i, w->n);
+        binaryBlockMatrixMul(a_frag, b_panel[i], acc);
+    }
+    storeAcc(acc, result, blockRow, blockCol, w->k);
+}
+
+static void fastPreparedTileMul(const BinaryMatrix_t a, const BinaryWeights_t* w, BinaryMatrix_t c, uint32_t signCmp, uint32_t blockRow, uint32_t blockCol){
+    const uint32_t blockN = w->n / BINARY_FRAG_SIZE;
+    const BinaryFragment_t* b_panel = w->frags + blockCol * blockN;
+    BinaryFragment_t a_frag;
+    BinaryFragment_t c_frag;
+    BinaryAcc_t acc;
+    fillAccWithZero(acc);
+    for(int i = 0; i < blockN; ++i){
+        loadFragment(a_frag, a, blockRow, i, w->n);
+        fastBinaryBlockMatrixMul(a_frag, b_panel[i], acc, c_frag, signCmp, i == blockN - 1);
+    }
+    storeFragment(c_frag, c, blockRow, blockCol, w->k);
+}
+
+void binaryMatrixMulPrepared(const BinaryMatrix_t a, const BinaryWeights_t* w, Matrix_t result, uint32_t m){
+    binaryMatrixMulBatched(&a, w, 1, result, m * w->k, 1, m);
+}
+
+void fastBinaryMatrixMulPrepared(const BinaryMatrix_t a, const BinaryWeights_t* w, BinaryMatrix_t c, uint32_t signCmp, uint32_t m){
+    fastBinaryMatrixMulBatched(&a, w, 1, c, m * w->k / 32, signCmp, 1, m);
+}
+
+bool binaryMatrixMulBatched(const BinaryMatrix_t a[], const BinaryWeights_t w[], uint32_t wCount, Matrix_t result, uint32_t resultStride, uint32_t batch, uint32_t m){
+    if(batch == 0 || (wCount != 1 && wCount != batch)){
+        return false;
+    }
+    const uint32_t blockM = m / BINARY_FRAG_SIZE;
+    if(wCount == 1){
+        const uint32_t blockK = w[0].k / BINARY_FRAG_SIZE;
+        // Pannello di pesi esterno: ogni blocco colonna viene riusato da tutto il batch
+        for(int blockCol = 0; blockCol < blockK; ++blockCol){
+            for(int item = 0; item < batch; ++item){
+                for(int blockRow = 0; blockRow < blockM; ++blockRow){
+                    preparedTileMul(a[item], &w[0], result + item * resultStride, blockRow, blockCol);
+                }
+            }
+        }
+    }else{
+        // Ogni input ha i propri pesi, quindi le proprie dimensioni n e k
+        for(int item = 0; item < batch; ++item){
+            const uint32_t blockK = w[item].k / BINARY_FRAG_SIZE;
+            for(int blockCol = 0; blockCol < blockK; ++blockCol){
+                for(int blockRow = 0; blockRow < blockM; ++blockRow){
+                    preparedTileMul(a[item], &w[item], result + item * resultStride, blockRow, blockCol);
+                }
+            }
+        }
+    }
+    return true;
+}
+
+bool fastBinaryMatrixMulBatched(const BinaryMatrix_t a[], const BinaryWeights_t w[], uint32_t wCount, BinaryMatrix_t c, uint32_t cStride, uint32_t signCmp, uint32_t batch, uint32_t m){
+    if(batch == 0 || (wCount != 1 && wCount != batch)){
+        return false;
+    }
+    const uint32_t blockM = m / BINARY_FRAG_SIZE;
+    if(wCount == 1){
+        const uint32_t blockK = w[0].k / BINARY_FRAG_SIZE;
+        // Pannello di pesi esterno: ogni blocco colonna viene riusato da tutto il batch
+        for(int blockCol = 0; blockCol < blockK; ++blockCol){
+            for(int item = 0; item < batch; ++item){
+                for(int blockRow = 0; blockRow < blockM; ++blockRow){
+                    fastPreparedTileMul(a[item], &w[0], c + item * cStride, signCmp, blockRow, blockCol);
+                }
+            }
+        }
+    }else{
+        // Ogni input ha i propri pesi, quindi le proprie dimensioni n e k
+        for(int item = 0; item < batch; ++item){
+            const uint32_t blockK = w[item].k / BINARY_FRAG_SIZE;
+            for(int blockCol = 0; blockCol < blockK; ++blockCol){
+                for(int blockRow = 0; blockRow < blockM; ++blockRow){
+                    fastPreparedTileMul(a[item], &w[item], c + item * cStride, signCmp, blockRow, blockCol);
+                }
+            }
+        }
+    }
+    return true;
+}
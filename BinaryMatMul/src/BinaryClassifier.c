@@ -0,0 +1,69 @@
+#include <BinaryClassifier.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+
+/// Inserisce (index, score) nella classifica ordinata della riga se batte l'ultimo elemento
+static void insertTopK(uint32_t* bestIdx, uint32_t* bestScore, uint32_t* count, uint32_t topK, uint32_t index, uint32_t score){
+    if(*count == topK && score <= bestScore[topK - 1]){
+        return;
+    }
+    int pos = *count < topK ? (*count)++ : topK - 1;
+    // Le classi arrivano in ordine crescente: a parita' di punteggio resta davanti quella gia' presente
+    while(pos > 0 && bestScore[pos - 1] < score){
+        bestIdx[pos] = bestIdx[pos - 1];
+        bestScore[pos] = bestScore[pos - 1];
+        --pos;
+    }
+    bestIdx[pos] = index;
+    bestScore[pos] = score;
+}
+
+bool binaryClassifierTopK(const BinaryMatrix_t a, const BinaryWeights_t* w, uint32_t m, uint32_t classes, uint32_t topK, uint32_t* indices, uint32_t* scores){
+    if(topK == 0 || topK > BINARY_TOPK_MAX || topK > classes || classes > w->k){
+        return false;
+    }
+    const uint32_t blockM = m / BINARY_FRAG_SIZE;
+    const uint32_t blockN = w->n / BINARY_FRAG_SIZE;
+    const uint32_t blockK = (classes + BINARY_FRAG_SIZE - 1) / BINARY_FRAG_SIZE;
+    BinaryFragment_t a_frag;
+    BinaryAcc_t acc;
+    uint32_t bestIdx[BINARY_FRAG_SIZE][BINARY_TOPK_MAX];
+    uint32_t bestScore[BINARY_FRAG_SIZE][BINARY_TOPK_MAX];
+    uint32_t bestCount[BINARY_FRAG_SIZE];
+
+    for(int blockRow = 0; blockRow < blockM; ++blockRow){
+        for(int row = 0; row < BINARY_FRAG_SIZE; ++row){
+            bestCount[row] = 0;
+        }
+        for(int blockCol = 0; blockCol < blockK; ++blockCol){
+            const BinaryFragment_t* b_panel = w->frags + blockCol * blockN;
+            fillAccWithZero(acc);
+            for(int i = 0; i < blockN; ++i){
+                loadFragment(a_frag, a, blockRow, i, w->n);
+                binaryBlockMatrixMul(a_frag, b_panel[i], acc);
+            }
+            // Consuma l'accumulatore: nessun punteggio viene scritto in memoria
+            for(int row = 0; row < BINARY_FRAG_SIZE; ++row){
+                for(int col = 0; col < BINARY_FRAG_SIZE && blockCol * BINARY_FRAG_SIZE + col < classes; ++col){
+                    insertTopK(bestIdx[row], bestScore[row], &bestCount[row], topK, blockCol * BINARY_FRAG_SIZE + col, acc[row][col]);
+                }
+            }
+        }
+        for(int row = 0; row < BINARY_FRAG_SIZE; ++row){
+            const uint32_t outRow = (blockRow * BINARY_FRAG_SIZE + row) * topK;
+            for(int j = 0; j < topK; ++j){
+                indices[outRow + j] = bestIdx[row][j];
+                if(scores != NULL){
+                    scores[outRow + j] = bestScore[row][j];
+                }
+            }
+        }
+    }
+    return true;
+}
+
+bool binaryClassifierArgmax(const BinaryMatrix_t a, const BinaryWeights_t* w, uint32_t m, uint32_t classes, uint32_t* indices){
+    return binaryClassifierTopK(a, w, m, classes, 1, indices, NULL);
+}
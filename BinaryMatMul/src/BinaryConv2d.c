@@ -0,0 +1,194 @@
+#include <BinaryConv2d.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+
+/// Restituisce una maschera con i primi len bit (MSB first) a 1
+static uint32_t leadingOnes(uint32_t len){
+    return len >= 32 ? 0xFFFFFFFFu : ~(0xFFFFFFFFu >> len);
+}
+
+/// Legge len bit (1..32) a partire dalla posizione pos dello stream, allineati al MSB
+static uint32_t readBits(const uint32_t* stream, uint32_t pos, uint32_t len){
+    const uint32_t word = pos / 32;
+    const uint32_t offset = pos % 32;
+    uint32_t value = stream[word] << offset;
+    if(offset + len > 32){
+        value |= stream[word + 1] >> (32 - offset);
+    }
+    return value & leadingOnes(len);
+}
+
+/*
+    Costruisce la parola wordIdx della riga im2col del pixel di uscita (oy, ox). La finestra viene
+    percorsa per segmenti contigui (una riga ky del filtro alla volta), leggendo dallo stream solo la
+    parte che cade dentro la feature map; in mask vengono segnati i bit validi.
+*/
+static uint32_t convRowWord(const BinaryMatrix_t input, const BinaryConv2dParams_t* p, uint32_t oy, uint32_t ox, uint32_t wordIdx, uint32_t* mask){
+    const uint32_t rowBits = p->kW * p->inC;
+    const uint32_t kBits = p->kH * rowBits;
+    const int32_t ix0 = (int32_t)(ox * p->stride) - (int32_t)p->pad;
+    const int32_t kxLo = ix0 < 0 ? -ix0 : 0;
+    const int32_t kxHi = ix0 + (int32_t)p->kW > (int32_t)p->inW ? (int32_t)p->inW - ix0 : (int32_t)p->kW;
+    const uint32_t start = wordIdx * 32;
+    const uint32_t end = start + 32 < kBits ? start + 32 : kBits;
+    uint32_t word = 0;
+    uint32_t valid = 0;
+
+    for(uint32_t t = start; t < end;){
+        const uint32_t ky = t / rowBits;
+        const uint32_t rem = t % rowBits;
+        const uint32_t len = end - t < rowBits - rem ? end - t : rowBits - rem;
+        const int32_t iy = (int32_t)(oy * p->stride + ky) - (int32_t)p->pad;
+        if(iy >= 0 && iy < (int32_t)p->inH && kxLo < kxHi){
+            const uint32_t bitLo = kxLo * p->inC;
+            const uint32_t bitHi = kxHi * p->inC;
+            const uint32_t s0 = rem > bitLo ? rem : bitLo;
+            const uint32_t s1 = rem + len < bitHi ? rem + len : bitHi;
+            if(s0 < s1){
+                const uint32_t pos = (uint32_t)((iy * (int32_t)p->inW + ix0) * (int32_t)p->inC) + s0;
+                const uint32_t offset = (t - start) + (s0 - rem);
+                word  |= readBits(input, pos, s1 - s0) >> offset;
+                valid |= leadingOnes(s1 - s0) >> offset;
+            }
+        }
+        t += len;
+    }
+    *mask = valid;
+    return word;
+}
+
+void binaryConv2dOutputSize(const BinaryConv2dParams_t* params, uint32_t* outH, uint32_t* outW){
+    uint32_t h = (params->inH + 2 * params->pad - params->kH) / params->stride + 1;
+    uint32_t w = (params->inW + 2 * params->pad - params->kW) / params->stride + 1;
+    if(params->poolSize > 1){
+        h /= params->poolSize;
+        w /= params->poolSize;
+    }
+    *outH = h;
+    *outW = w;
+}
+
+uint32_t binaryConv2dFilterWords(const BinaryConv2dParams_t* params){
+    return (params->kH * params->kW * params->inC + 31) / 32;
+}
+
+bool binaryConv2dAllocWorkspace(BinaryConv2dWorkspace_t* ws, const BinaryConv2dParams_t* params){
+    ws->filterWords = binaryConv2dFilterWords(params);
+    ws->aPanel = (BinaryFragment_t*)malloc(ws->filterWords * sizeof(BinaryFragment_t));
+    ws->padPanel = (BinaryFragment_t*)malloc(ws->filterWords * sizeof(BinaryFragment_t));
+    ws->hasPad = (bool*)malloc(ws->filterWords * sizeof(bool));
+    if(!ws->aPanel || !ws->padPanel || !ws->hasPad){
+        binaryConv2dFreeWorkspace(ws);
+        return false;
+    }
+    return true;
+}
+
+void binaryConv2dFreeWorkspace(BinaryConv2dWorkspace_t* ws){
+    free(ws->aPanel);
+    free(ws->padPanel);
+    free(ws->hasPad);
+    ws->aPanel = NULL;
+    ws->padPanel = NULL;
+    ws->hasPad = NULL;
+    ws->filterWords = 0;
+}
+
+void binaryConv2d(const BinaryMatrix_t input, const BinaryMatrix_t filters, BinaryMatrix_t output, uint32_t signCmp, const BinaryConv2dParams_t* params, BinaryConv2dWorkspace_t* ws){
+    const uint32_t convH = (params->inH + 2 * params->pad - params->kH) / params->stride + 1;
+    const uint32_t convW = (params->inW + 2 * params->pad - params->kW) / params->stride + 1;
+    const uint32_t pixels = convH * convW;
+    const uint32_t filterWords = binaryConv2dFilterWords(params);
+    const uint32_t outWords = params->outC / 32;
+    const uint32_t blockPixels = (pixels + BINARY_FRAG_SIZE - 1) / BINARY_FRAG_SIZE;
+    const uint32_t blockK = params->outC / BINARY_FRAG_SIZE;
+    const bool pooling = params->poolSize > 1;
+    uint32_t poolH = 0;
+    uint32_t poolW = 0;
+
+    BinaryFragment_t w_frag;
+    BinaryFragment_t w_zeros;
+    BinaryFragment_t c_frag;
+    BinaryAcc_t acc;
+    BinaryAcc_t padAcc;
+    uint32_t padBits[BINARY_FRAG_SIZE];
+
+    // Pannello della riga di blocchi: parole im2col e bit di padding, costruiti una volta per tutti i blockCol
+    BinaryFragment_t* a_panel = ws->aPanel;
+    BinaryFragment_t* mask_panel = ws->padPanel;
+    bool* hasPad = ws->hasPad;
+
+    if(pooling){
+        binaryConv2dOutputSize(params, &poolH, &poolW);
+        for(int i = 0; i < poolH * poolW * outWords; ++i){
+            output[i] = 0;
+        }
+    }
+
+    for(int blockRow = 0; blockRow < blockPixels; ++blockRow){
+        for(int row = 0; row < BINARY_FRAG_SIZE; ++row){
+            padBits[row] = 0;
+        }
+        for(int i = 0; i < filterWords; ++i){
+            hasPad[i] = false;
+            for(int row = 0; row < BINARY_FRAG_SIZE; ++row){
+                const uint32_t pixel = blockRow * BINARY_FRAG_SIZE + row;
+                if(pixel < pixels){
+                    a_panel[i][row] = convRowWord(input, params, pixel / convW, pixel % convW, i, &mask_panel[i][row]);
+                }else{
+                    a_panel[i][row] = 0;
+                    mask_panel[i][row] = 0;
+                }
+                // Da qui mask_panel contiene i bit di padding
+                mask_panel[i][row] = ~mask_panel[i][row];
+                padBits[row] += popcount32(mask_panel[i][row]);
+                hasPad[i] |= mask_panel[i][row] != 0;
+            }
+        }
+
+        for(int blockCol = 0; blockCol < blockK; ++blockCol){
+            fillAccWithZero(acc);
+            fillAccWithZero(padAcc);
+            for(int i = 0; i < filterWords; ++i){
+                // I filtri sono gia' memorizzati per canale di uscita, cioe' come frammento trasposto
+                for(int col = 0; col < BINARY_FRAG_SIZE; ++col){
+                    w_frag[col] = filters[(blockCol * BINARY_FRAG_SIZE + col) * filterWords + i];
+                    w_zeros[col] = ~w_frag[col];
+                }
+                binaryBlockMatrixMul(a_panel[i], w_frag, acc);
+                if(hasPad[i]){
+                    // I bit di padding di A sono a 0: lo XNOR li conta come match dove il filtro vale 0
+                    binaryAndBlockMatrixMul(mask_panel[i], w_zeros, padAcc);
+                }
+            }
+
+            // Binarizza il risultato: ogni bit di padding vale mezzo match
+            for(int row = 0; row < BINARY_FRAG_SIZE; ++row){
+                for(int col = 0; col < BINARY_FRAG_SIZE; ++col){
+                    const uint32_t matches = acc[row][col] - padAcc[row][col];
+                    setBit(c_frag, row, col, 2 * matches + padBits[row] > 2 * signCmp, BINARY_FRAG_SIZE);
+                }
+            }
+
+            if(pooling){
+                // Max-pool binario fuso: OR dei bit nella cella di pooling
+                for(int row = 0; row < BINARY_FRAG_SIZE; ++row){
+                    const uint32_t pixel = blockRow * BINARY_FRAG_SIZE + row;
+                    const uint32_t py = (pixel / convW) / params->poolSize;
+                    const uint32_t px = (pixel % convW) / params->poolSize;
+                    if(pixel < pixels && py < poolH && px < poolW){
+                        output[(py * poolW + px) * outWords + blockCol] |= c_frag[row];
+                    }
+                }
+            }else if((blockRow + 1) * BINARY_FRAG_SIZE <= pixels){
+                storeFragment(c_frag, output, blockRow, blockCol, params->outC);
+            }else{
+                for(int row = 0; blockRow * BINARY_FRAG_SIZE + row < pixels; ++row){
+                    output[(blockRow * BINARY_FRAG_SIZE + row) * outWords + blockCol] = c_frag[row];
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,222 @@
+#include <BinaryHammingSearch.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+/// Parola word del vettore v nel layout a frammenti
+static inline uint32_t dbWord(const HammingDatabase_t* db, uint32_t v, uint32_t word){
+    return db->frags[(v / BINARY_FRAG_SIZE) * (db->dim / 32) + word][v % BINARY_FRAG_SIZE];
+}
+
+/// Sottostringa j (16 bit) di un vettore, a partire dal MSB
+static inline uint16_t substringOf(uint32_t word, uint32_t j){
+    return (j % 2 == 0) ? (uint16_t)(word >> 16) : (uint16_t)(word & 0xFFFF);
+}
+
+/// Inserisce (index, dist) nella classifica ordinata per (distanza, indice)
+static void insertNeighbour(uint32_t* idx, uint32_t* dist, uint32_t* count, uint32_t topK, uint32_t index, uint32_t d){
+    if(*count == topK && (d > dist[topK - 1] || (d == dist[topK - 1] && index > idx[topK - 1]))){
+        return;
+    }
+    int pos = *count < topK ? (*count)++ : topK - 1;
+    while(pos > 0 && (dist[pos - 1] > d || (dist[pos - 1] == d && idx[pos - 1] > index))){
+        idx[pos] = idx[pos - 1];
+        dist[pos] = dist[pos - 1];
+        --pos;
+    }
+    idx[pos] = index;
+    dist[pos] = d;
+}
+
+/*
+    Valuta i vettori del blocco blk per la query. Le distanze dei 32 vettori crescono insieme, una parola
+    alla volta, e a classifica piena il blocco viene abbandonato appena tutte le distanze parziali superano
+    quella del k-esimo migliore. I vettori segnati in skipMask (bit row) non vengono inseriti.
+*/
+static void scanBlock(const HammingDatabase_t* db, uint32_t blk, const uint32_t* query, uint32_t skipMask,
+                      uint32_t* idx, uint32_t* dist, uint32_t* count, uint32_t topK){
+    const uint32_t words = db->dim / 32;
+    const BinaryFragment_t* frags = db->frags + blk * words;
+    const uint32_t first = blk * BINARY_FRAG_SIZE;
+    const uint32_t rows = db->count - first < BINARY_FRAG_SIZE ? db->count - first : BINARY_FRAG_SIZE;
+    uint32_t d[BINARY_FRAG_SIZE] = {0};
+    for(int i = 0; i < words; ++i){
+        uint32_t minDist = UINT32_MAX;
+        for(int row = 0; row < BINARY_FRAG_SIZE; ++row){
+            d[row] += popcount32(query[i] ^ frags[i][row]);
+            minDist = d[row] < minDist ? d[row] : minDist;
+        }
+        if(*count == topK && minDist > dist[topK - 1]){
+            return;
+        }
+    }
+    for(int row = 0; row < rows; ++row){
+        if(!(skipMask & (1u << row))){
+            insertNeighbour(idx, dist, count, topK, first + row, d[row]);
+        }
+    }
+}
+
+bool hammingDatabaseLoad(HammingDatabase_t* db, const BinaryMatrix_t vectors, uint32_t count, uint32_t dim){
+    const uint32_t words = dim / 32;
+    const uint32_t blocks = (count + BINARY_FRAG_SIZE - 1) / BINARY_FRAG_SIZE;
+    db->count = count;
+    db->dim = dim;
+    db->frags = (BinaryFragment_t*)calloc(blocks * words, sizeof(BinaryFragment_t));
+    if(!db->frags){
+        return false;
+    }
+    for(int v = 0; v < count; ++v){
+        for(int i = 0; i < words; ++i){
+            db->frags[(v / BINARY_FRAG_SIZE) * words + i][v % BINARY_FRAG_SIZE] = vectors[v * words + i];
+        }
+    }
+    return true;
+}
+
+void hammingDatabaseFree(HammingDatabase_t* db){
+    free(db->frags);
+    db->frags = NULL;
+}
+
+bool hammingKnnSearch(const HammingDatabase_t* db, const BinaryMatrix_t queries, uint32_t qCount, uint32_t topK, uint32_t* indices, uint32_t* distances){
+    if(topK == 0 || topK > HAMMING_TOPK_MAX || topK > db->count){
+        return false;
+    }
+    const uint32_t words = db->dim / 32;
+    const uint32_t blocks = (db->count + BINARY_FRAG_SIZE - 1) / BINARY_FRAG_SIZE;
+    // Le classifiche vengono costruite direttamente nei buffer di uscita
+    for(int blk = 0; blk < blocks; ++blk){
+        const uint32_t first = blk * BINARY_FRAG_SIZE;
+        for(int q = 0; q < qCount; ++q){
+            uint32_t count = first < topK ? first : topK;
+            scanBlock(db, blk, queries + q * words, 0, indices + q * topK, distances + q * topK, &count, topK);
+        }
+    }
+    return true;
+}
+
+static int compareKeyId(const void* a, const void* b){
+    uint64_t x = *(const uint64_t*)a;
+    uint64_t y = *(const uint64_t*)b;
+    return x < y ? -1 : (x > y ? 1 : 0);
+}
+
+bool hammingIndexBuild(HammingIndex_t* index, const HammingDatabase_t* db){
+    const uint32_t count = db->count;
+    index->db = db;
+    index->substrings = db->dim / HAMMING_MIH_SUBSTRING_BITS;
+    index->keys = (uint16_t*)malloc(index->substrings * count * sizeof(uint16_t));
+    index->ids = (uint32_t*)malloc(index->substrings * count * sizeof(uint32_t));
+    index->visited = (uint32_t*)malloc(((count + 31) / 32) * sizeof(uint32_t));
+    uint64_t* pairs = (uint64_t*)malloc(count * sizeof(uint64_t));
+    if(!index->keys || !index->ids || !index->visited || !pairs){
+        free(pairs);
+        hammingIndexFree(index);
+        return false;
+    }
+    for(int j = 0; j < index->substrings; ++j){
+        for(int v = 0; v < count; ++v){
+            pairs[v] = ((uint64_t)substringOf(dbWord(db, v, j / 2), j) << 32) | (uint32_t)v;
+        }
+        qsort(pairs, count, sizeof(uint64_t), compareKeyId);
+        for(int v = 0; v < count; ++v){
+            index->keys[j * count + v] = (uint16_t)(pairs[v] >> 32);
+            index->ids[j * count + v] = (uint32_t)pairs[v];
+        }
+    }
+    free(pairs);
+    return true;
+}
+
+void hammingIndexFree(HammingIndex_t* index){
+    free(index->keys);
+    free(index->ids);
+    free(index->visited);
+    index->keys = NULL;
+    index->ids = NULL;
+    index->visited = NULL;
+}
+
+/// Primo elemento della tabella con chiave >= key
+static uint32_t lowerBound(const uint16_t* keys, uint32_t count, uint16_t key){
+    uint32_t lo = 0;
+    uint32_t hi = count;
+    while(lo < hi){
+        uint32_t mid = (lo + hi) / 2;
+        if(keys[mid] < key){
+            lo = mid + 1;
+        }else{
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+/// Valuta tutti i vettori della sottostringa j con chiave key non ancora visitati
+static void probeBucket(HammingIndex_t* index, const uint32_t* query, uint32_t j, uint16_t key,
+                        uint32_t* idx, uint32_t* dist, uint32_t* count, uint32_t topK){
+    const HammingDatabase_t* db = index->db;
+    const uint32_t words = db->dim / 32;
+    const uint16_t* keys = index->keys + j * db->count;
+    const uint32_t* ids = index->ids + j * db->count;
+    for(uint32_t pos = lowerBound(keys, db->count, key); pos < db->count && keys[pos] == key; ++pos){
+        const uint32_t v = ids[pos];
+        if(index->visited[v / 32] & (1u << (v % 32))){
+            continue;
+        }
+        index->visited[v / 32] |= 1u << (v % 32);
+        uint32_t d = 0;
+        for(int i = 0; i < words; ++i){
+            d += popcount32(query[i] ^ dbWord(db, v, i));
+        }
+        insertNeighbour(idx, dist, count, topK, v, d);
+    }
+}
+
+bool hammingIndexSearch(HammingIndex_t* index, const BinaryMatrix_t queries, uint32_t qCount, uint32_t topK, uint32_t* indices, uint32_t* distances){
+    const HammingDatabase_t* db = index->db;
+    if(topK == 0 || topK > HAMMING_TOPK_MAX || topK > db->count){
+        return false;
+    }
+    const uint32_t words = db->dim / 32;
+    const uint32_t maxMask = 1u << HAMMING_MIH_SUBSTRING_BITS;
+    for(int q = 0; q < qCount; ++q){
+        const uint32_t* query = queries + q * words;
+        uint32_t* idx = indices + q * topK;
+        uint32_t* dist = distances + q * topK;
+        uint32_t count = 0;
+        bool done = false;
+        memset(index->visited, 0, ((db->count + 31) / 32) * sizeof(uint32_t));
+
+        for(uint32_t r = 0; r <= HAMMING_MIH_MAX_RADIUS && !done; ++r){
+            if(count == topK && dist[topK - 1] >= index->substrings * (HAMMING_MIH_MAX_RADIUS + 1)){
+                break; // Nemmeno il raggio massimo basterebbe: meglio passare subito alla forza bruta
+            }
+            for(int j = 0; j < index->substrings; ++j){
+                const uint16_t qKey = substringOf(query[j / 2], j);
+                // Enumera le maschere a 16 bit con r bit a 1 (Gosper's hack)
+                for(uint32_t mask = (1u << r) - 1; mask < maxMask;){
+                    probeBucket(index, query, j, qKey ^ (uint16_t)mask, idx, dist, &count, topK);
+                    if(mask == 0){
+                        break;
+                    }
+                    uint32_t c = mask & -mask;
+                    uint32_t n = mask + c;
+                    mask = (((n ^ mask) >> 2) / c) | n;
+                }
+            }
+            // Tutti i vettori a distanza < substrings * (r + 1) sono gia' stati valutati
+            done = count == topK && dist[topK - 1] < index->substrings * (r + 1);
+        }
+
+        if(!done){
+            for(uint32_t blk = 0; blk < (db->count + BINARY_FRAG_SIZE - 1) / BINARY_FRAG_SIZE; ++blk){
+                scanBlock(db, blk, query, index->visited[blk], idx, dist, &count, topK);
+            }
+        }
+    }
+    return true;
+}
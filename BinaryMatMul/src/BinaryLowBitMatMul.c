@@ -0,0 +1,255 @@
+#include <BinaryLowBitMatMul.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+
+typedef int32_t LowBitTile_t[BINARY_FRAG_SIZE][BINARY_FRAG_SIZE];
+
+bool allocBitPlaneMatrix(BitPlaneMatrix_t* mat, uint32_t rows, uint32_t cols, uint8_t bits, BitPlaneEncoding_t encoding){
+    if(bits == 0 || bits > BINARY_MAX_PLANES){
+        return false;
+    }
+    mat->bits = bits;
+    mat->encoding = encoding;
+    mat->rows = rows;
+    mat->cols = cols;
+    for(int p = 0; p < BINARY_MAX_PLANES; ++p){
+        mat->planes[p] = NULL;
+    }
+    for(int p = 0; p < bits; ++p){
+        mat->planes[p] = (BinaryMatrix_t)calloc(rows * (cols / 32), sizeof(uint32_t));
+        if(!mat->planes[p]){
+            freeBitPlaneMatrix(mat);
+            return false;
+        }
+    }
+    return true;
+}
+
+void freeBitPlaneMatrix(BitPlaneMatrix_t* mat){
+    for(int p = 0; p < BINARY_MAX_PLANES; ++p){
+        free(mat->planes[p]);
+        mat->planes[p] = NULL;
+    }
+}
+
+int32_t bitPlaneCodeToValue(uint8_t code, uint8_t bits, BitPlaneEncoding_t encoding){
+    if(encoding == BITPLANE_BIPOLAR){
+        // sum_p 2^p * (2 * b_p - 1) = 2 * code - (2^bits - 1)
+        return 2 * (int32_t)code - ((1 << bits) - 1);
+    }
+    return code;
+}
+
+void packBitPlanes(const uint8_t* codes, BitPlaneMatrix_t* mat){
+    for(int p = 0; p < mat->bits; ++p){
+        for(int i = 0; i < mat->rows; ++i){
+            for(int j = 0; j < mat->cols; ++j){
+                setBit(mat->planes[p], i, j, (codes[i * mat->cols + j] >> p) & 1, mat->cols);
+            }
+        }
+    }
+}
+
+void unpackBitPlanes(const BitPlaneMatrix_t* mat, uint8_t* codes){
+    for(int i = 0; i < mat->rows; ++i){
+        for(int j = 0; j < mat->cols; ++j){
+            uint8_t code = 0;
+            for(int p = 0; p < mat->bits; ++p){
+                code |= getBit(mat->planes[p], i, j, mat->cols) << p;
+            }
+            codes[i * mat->cols + j] = code;
+        }
+    }
+}
+
+void binarizeMatrixToBitPlanes(const Matrix_t mat, BitPlaneMatrix_t* planes, uint32_t offset, uint32_t step){
+    const uint32_t maxCode = (1u << planes->bits) - 1;
+    for(int i = 0; i < planes->rows; ++i){
+        for(int j = 0; j < planes->cols; ++j){
+            uint32_t value = mat[i * planes->cols + j];
+            uint32_t code = value > offset ? (value - offset) / step : 0;
+            if(code > maxCode){
+                code = maxCode;
+            }
+            for(int p = 0; p < planes->bits; ++p){
+                setBit(planes->planes[p], i, j, (code >> p) & 1, planes->cols);
+            }
+        }
+    }
+}
+
+static void fillTileWithZero(LowBitTile_t tile){
+    for(int row = 0; row < BINARY_FRAG_SIZE; ++row){
+        for(int col = 0; col < BINARY_FRAG_SIZE; ++col){
+            tile[row][col] = 0;
+        }
+    }
+}
+
+/*
+    Somma al tile il prodotto della coppia di plane (p, q) calcolato nell'accumulatore.
+    Con codifiche miste il kernel usato e' l'AND-popcount e il prodotto con segno vale
+    2 * acc - popcount del plane senza segno; con entrambi bipolari vale 2 * acc - 32.
+*/
+static void accumulatePlanePair(LowBitTile_t tile, const BinaryAcc_t acc, const BinaryFragment_t a, const BinaryFragment_t bT,
+                                uint32_t shift, BitPlaneEncoding_t encA, BitPlaneEncoding_t encB){
+    const int32_t weight = 1 << shift;
+    for(int row = 0; row < BINARY_FRAG_SIZE; ++row){
+        const int32_t rowOnes = popcount32(a[row]);
+        for(int col = 0; col < BINARY_FRAG_SIZE; ++col){
+            int32_t value = acc[row][col];
+            if(encA == BITPLANE_BIPOLAR && encB == BITPLANE_BIPOLAR){
+                value = 2 * value - BINARY_FRAG_SIZE;
+            }else if(encA == BITPLANE_UNSIGNED && encB == BITPLANE_BIPOLAR){
+                value = 2 * value - rowOnes;
+            }else if(encA == BITPLANE_BIPOLAR && encB == BITPLANE_UNSIGNED){
+                value = 2 * value - popcount32(bT[col]);
+            }
+            tile[row][col] += value * weight;
+        }
+    }
+}
+
+/*
+    Calcola il tile (blockRow, blockCol) del prodotto. I frammenti di ogni plane vengono
+    caricati (e per B trasposti) una sola volta per indice i e riusati da tutte le coppie.
+*/
+static void lowBitTileMul(const BitPlaneMatrix_t* a, const BitPlaneMatrix_t* b, LowBitTile_t tile, uint32_t blockRow, uint32_t blockCol){
+    const uint32_t n = a->cols;
+    const uint32_t k = b->cols;
+    const uint32_t blockN = n / BINARY_FRAG_SIZE;
+    const bool useXnor = a->encoding == BITPLANE_BIPOLAR && b->encoding == BITPLANE_BIPOLAR;
+    BinaryFragment_t a_frags[BINARY_MAX_PLANES];
+    BinaryFragment_t b_transposed[BINARY_MAX_PLANES];
+    BinaryFragment_t b_frag;
+    BinaryAcc_t acc;
+
+    fillTileWithZero(tile);
+    for(int i = 0; i < blockN; ++i){
+        for(int p = 0; p < a->bits; ++p){
+            loadFragment(a_frags[p], a->planes[p], blockRow, i, n);
+        }
+        for(int q = 0; q < b->bits; ++q){
+            loadFragment(b_frag, b->planes[q], i, blockCol, k);
+            transposeBinaryFragment(b_frag, b_transposed[q]);
+        }
+        for(int p = 0; p < a->bits; ++p){
+            for(int q = 0; q < b->bits; ++q){
+                fillAccWithZero(acc);
+                if(useXnor){
+                    binaryBlockMatrixMul(a_frags[p], b_transposed[q], acc);
+                }else{
+                    binaryAndBlockMatrixMul(a_frags[p], b_transposed[q], acc);
+                }
+                accumulatePlanePair(tile, acc, a_frags[p], b_transposed[q], p + q, a->encoding, b->encoding);
+            }
+        }
+    }
+}
+
+void lowBitMatrixMul(const BitPlaneMatrix_t* a, const BitPlaneMatrix_t* b, IntMatrix_t result){
+    const uint32_t k = b->cols;
+    const uint32_t blockM = a->rows / BINARY_FRAG_SIZE;
+    const uint32_t blockK = k / BINARY_FRAG_SIZE;
+    LowBitTile_t tile;
+    for(int blockRow = 0; blockRow < blockM; ++blockRow){
+        for(int blockCol = 0; blockCol < blockK; ++blockCol){
+            lowBitTileMul(a, b, tile, blockRow, blockCol);
+            int32_t* out = result + blockRow * BINARY_FRAG_SIZE * k + blockCol * BINARY_FRAG_SIZE;
+            for(int row = 0; row < BINARY_FRAG_SIZE; ++row){
+                for(int col = 0; col < BINARY_FRAG_SIZE; ++col){
+                    out[row * k + col] = tile[row][col];
+                }
+            }
+        }
+    }
+}
+
+void fastLowBitMatrixMul(const BitPlaneMatrix_t* a, const BitPlaneMatrix_t* b, BinaryMatrix_t c, int32_t threshold){
+    const uint32_t k = b->cols;
+    const uint32_t blockM = a->rows / BINARY_FRAG_SIZE;
+    const uint32_t blockK = k / BINARY_FRAG_SIZE;
+    LowBitTile_t tile;
+    BinaryFragment_t c_frag;
+    for(int blockRow = 0; blockRow < blockM; ++blockRow){
+        for(int blockCol = 0; blockCol < blockK; ++blockCol){
+            lowBitTileMul(a, b, tile, blockRow, blockCol);
+            for(int row = 0; row < BINARY_FRAG_SIZE; ++row){
+                for(int col = 0; col < BINARY_FRAG_SIZE; ++col){
+                    setBit(c_frag, row, col, tile[row][col] > threshold, BINARY_FRAG_SIZE);
+                }
+            }
+            storeFragment(c_frag, c, blockRow, blockCol, k);
+        }
+    }
+}
+
+bool lowBitMatrixMulBTPU(const BTPUDevice_t* dev, const BitPlaneMatrix_t* a, const BitPlaneMatrix_t* b, BinaryMatrix_t c, int32_t threshold){
+    if(a->encoding != BITPLANE_BIPOLAR || b->encoding != BITPLANE_BIPOLAR || a->cols != b->rows){
+        return false; // La BTPU calcola solo lo XNOR-popcount
+    }
+    const uint32_t m = a->rows;
+    const uint32_t n = a->cols;
+    const uint32_t k = b->cols;
+    const uint32_t blockM = m / BINARY_FRAG_SIZE;
+    const uint32_t blockN = n / BINARY_FRAG_SIZE;
+    const uint32_t blockK = k / BINARY_FRAG_SIZE;
+    const uint32_t aPlaneBlocks = blockM * blockN;
+    const uint32_t bPlaneBlocks = blockN * blockK;
+    const uint32_t oMemStartAddr = a->bits * aPlaneBlocks;
+
+    // Con W = sum 2^(p + q) * xnor_pq il prodotto vale 2 * W - n * (2^bitsA - 1) * (2^bitsB - 1)
+    const int64_t bias = (int64_t)n * ((1 << a->bits) - 1) * ((1 << b->bits) - 1);
+    const int64_t countCmp = (int64_t)threshold + bias;
+    if(countCmp < 0){
+        // Il prodotto minimo e' -bias > threshold: tutti i bit valgono 1
+        for(int i = 0; i < m * (k / 32); ++i){
+            c[i] = 0xFFFFFFFF;
+        }
+        return true;
+    }
+    const uint32_t signCmp = (uint32_t)(countCmp / 2);
+
+    if(oMemStartAddr + blockM * blockK > BTPU_MAX_BLOCK_COUNT || b->bits * bPlaneBlocks > BTPU_MAX_BLOCK_COUNT){
+        return false;
+    }
+
+    for(int p = 0; p < a->bits; ++p){
+        loadBinaryMatrixToFragments(a->planes[p], dev->io0Memory + p * aPlaneBlocks, m, n);
+    }
+    // B per blocchi colonna: i blockN blocchi di una colonna sono contigui, come richiesto da un job con kSize = 1
+    for(int q = 0; q < b->bits; ++q){
+        for(int blockCol = 0; blockCol < blockK; ++blockCol){
+            for(int i = 0; i < blockN; ++i){
+                loadFragment(dev->wMemory[q * bPlaneBlocks + blockCol * blockN + i], b->planes[q], i, blockCol, k);
+            }
+        }
+    }
+    btpuSetBlocks(dev->regs, 1, blockN, 1);
+
+    for(int blockRow = 0; blockRow < blockM; ++blockRow){
+        for(int blockCol = 0; blockCol < blockK; ++blockCol){
+            bool clearAcc = true;
+            for(int p = 0; p < a->bits; ++p){
+                for(int q = 0; q < b->bits; ++q){
+                    btpuSetAddrs(dev->regs, q * bPlaneBlocks + blockCol * blockN, p * aPlaneBlocks + blockRow * blockN,
+                                 oMemStartAddr + blockRow * blockK + blockCol);
+                    for(uint32_t rep = 0; rep < (1u << (p + q)); ++rep){
+                        if(!btpuDeviceStart(dev, signCmp, true, clearAcc, BTPU_USE_MEMORY_0_CONFIG)){
+                            return false;
+                        }
+                        if(!btpuDeviceWait(dev)){
+                            return false;
+                        }
+                        clearAcc = false;
+                    }
+                }
+            }
+        }
+    }
+
+    storeFramentsToBinaryMatrix(dev->io1Memory + oMemStartAddr, c, m, k);
+    return true;
+}
@@ -1,4 +1,5 @@
 #include <BinaryMatMul.h>
+#include <BinaryMatMulPlanner.h>
 
 #include <stdio.h>
 #include <stdlib.h>
@@ -69,6 +70,10 @@ uint32_t binaryMul(const uint32_t a, const uint32_t b) {
     return result; 
 }
 
+uint32_t binaryAndMul(const uint32_t a, const uint32_t b) {
+    return popcount32(a & b);
+}
+
 void binaryBlockMatrixMul(const BinaryFragment_t a, const BinaryFragment_t b, BinaryAcc_t acc) {
     for (int row = 0; row < BINARY_FRAG_SIZE; ++row) {
         for (int col = 0; col < BINARY_FRAG_SIZE; ++col) {
@@ -77,6 +82,14 @@ void binaryBlockMatrixMul(const BinaryFragment_t a, const BinaryFragment_t b, Bi
     }
 }
 
+void binaryAndBlockMatrixMul(const BinaryFragment_t a, const BinaryFragment_t b, BinaryAcc_t acc) {
+    for (int row = 0; row < BINARY_FRAG_SIZE; ++row) {
+        for (int col = 0; col < BINARY_FRAG_SIZE; ++col) {
+            acc[row][col] += binaryAndMul(a[row], b[col]);
+        }
+    }
+}
+
 void fastBinaryBlockMatrixMul(const BinaryFragment_t a, const BinaryFragment_t b, BinaryAcc_t acc, BinaryFragment_t c, uint32_t signCmp, bool store) {
     for (int row = 0; row < BINARY_FRAG_SIZE; ++row) {
         for (int col = 0; col < BINARY_FRAG_SIZE; ++col) {
@@ -135,7 +148,52 @@ void fillAccWithZero(BinaryAcc_t acc) {
     }
 }
 
-void binaryMatrixMul(const BinaryMatrix_t a, const BinaryMatrix_t b, Matrix_t result, const int m, const int n, const int k) {
+static uint32_t panelBlocksSetting = 0;
+
+void binaryMatMulSetPanelBlocks(uint32_t panelBlocks){
+    panelBlocksSetting = panelBlocks;
+}
+
+/// Limita la dimensione richiesta del pannello alla capacita' dei buffer (0 = massimo consentito)
+static uint32_t clampPanelBlocks(uint32_t requested, uint32_t n, uint32_t k){
+    uint32_t blockN = n / BINARY_FRAG_SIZE;
+    uint32_t blockK = k / BINARY_FRAG_SIZE;
+    if(blockN == 0 || blockN > BINARY_MATMUL_A_PANEL_FRAGS){
+        return 0;
+    }
+    uint32_t panelBlocks = BINARY_MATMUL_B_PANEL_FRAGS / blockN;
+    if(requested != 0 && requested < panelBlocks){
+        panelBlocks = requested;
+    }
+    if(panelBlocks > blockK){
+        panelBlocks = blockK;
+    }
+    return panelBlocks;
+}
+
+uint32_t binaryMatMulGetPanelBlocks(uint32_t n, uint32_t k){
+    return clampPanelBlocks(panelBlocksSetting, n, k);
+}
+
+/// Carica e traspone una sola volta i frammenti dei blocchi colonna [blockCol, blockCol + cols) di B
+static void packBPanel(BinaryPanelWorkspace_t* ws, const BinaryMatrix_t b, uint32_t blockCol, uint32_t cols, uint32_t blockN, uint32_t k){
+    BinaryFragment_t b_frag;
+    for(int col = 0; col < cols; ++col){
+        for(int i = 0; i < blockN; ++i){
+            loadFragment(b_frag, b, i, blockCol + col, k);
+            transposeBinaryFragment(b_frag, ws->b[col * blockN + i]);
+        }
+    }
+}
+
+/// Raccoglie i frammenti della riga di blocchi blockRow di A
+static void packAPanel(BinaryPanelWorkspace_t* ws, const BinaryMatrix_t a, uint32_t blockRow, uint32_t blockN, uint32_t n){
+    for(int i = 0; i < blockN; ++i){
+        loadFragment(ws->a[i], a, blockRow, i, n);
+    }
+}
+
+static void binaryMatrixMulUnpacked(const BinaryMatrix_t a, const BinaryMatrix_t b, Matrix_t result, const int m, const int n, const int k) {
     uint32_t blockM = m / BINARY_FRAG_SIZE;
     uint32_t blockN = n / BINARY_FRAG_SIZE;
     uint32_t blockK = k / BINARY_FRAG_SIZE;
@@ -157,7 +215,7 @@ void binaryMatrixMul(const BinaryMatrix_t a, const BinaryMatrix_t b, Matrix_t re
     }
 }
 
-void fastBinaryMatrixMul(const BinaryMatrix_t a, const BinaryMatrix_t b, BinaryMatrix_t c, uint32_t signCmp, const int m, const int n, const int k){
+static void fastBinaryMatrixMulUnpacked(const BinaryMatrix_t a, const BinaryMatrix_t b, BinaryMatrix_t c, uint32_t signCmp, const int m, const int n, const int k){
     uint32_t blockM = m / BINARY_FRAG_SIZE;
     uint32_t blockN = n / BINARY_FRAG_SIZE;
     uint32_t blockK = k / BINARY_FRAG_SIZE;
@@ -180,6 +238,89 @@ void fastBinaryMatrixMul(const BinaryMatrix_t a, const BinaryMatrix_t b, BinaryM
     }
 }
 
+void binaryMatrixMulPanel(const BinaryMatrix_t a, const BinaryMatrix_t b, Matrix_t result, const int m, const int n, const int k, uint32_t panelBlocks, BinaryPanelWorkspace_t* ws) {
+    uint32_t blockM = m / BINARY_FRAG_SIZE;
+    uint32_t blockN = n / BINARY_FRAG_SIZE;
+    uint32_t blockK = k / BINARY_FRAG_SIZE;
+    BinaryAcc_t acc;
+    panelBlocks = panelBlocks == 0 || ws == NULL ? 0 : clampPanelBlocks(panelBlocks, n, k);
+    if(panelBlocks == 0){
+        binaryMatrixMulUnpacked(a, b, result, m, n, k);
+        return;
+    }
+    for(int panelCol = 0; panelCol < blockK; panelCol += panelBlocks){
+        uint32_t cols = blockK - panelCol < panelBlocks ? blockK - panelCol : panelBlocks;
+        packBPanel(ws, b, panelCol, cols, blockN, k);
+        for(int blockRow = 0; blockRow < blockM; ++blockRow){
+            packAPanel(ws, a, blockRow, blockN, n);
+            for (int col = 0; col < cols; ++col) {
+                fillAccWithZero(acc);
+                for (int i = 0; i < blockN; ++i) {
+                    binaryBlockMatrixMul(ws->a[i], ws->b[col * blockN + i], acc);
+                }
+                storeAcc(acc, result, blockRow, panelCol + col, k);
+            }
+        }
+    }
+}
+
+void fastBinaryMatrixMulPanel(const BinaryMatrix_t a, const BinaryMatrix_t b, BinaryMatrix_t c, uint32_t signCmp, const int m, const int n, const int k, uint32_t panelBlocks, BinaryPanelWorkspace_t* ws){
+    uint32_t blockM = m / BINARY_FRAG_SIZE;
+    uint32_t blockN = n / BINARY_FRAG_SIZE;
+    uint32_t blockK = k / BINARY_FRAG_SIZE;
+    BinaryFragment_t c_frag;
+    BinaryAcc_t acc;
+    panelBlocks = panelBlocks == 0 || ws == NULL ? 0 : clampPanelBlocks(panelBlocks, n, k);
+    if(panelBlocks == 0){
+        fastBinaryMatrixMulUnpacked(a, b, c, signCmp, m, n, k);
+        return;
+    }
+    for(int panelCol = 0; panelCol < blockK; panelCol += panelBlocks){
+        uint32_t cols = blockK - panelCol < panelBlocks ? blockK - panelCol : panelBlocks;
+        packBPanel(ws, b, panelCol, cols, blockN, k);
+        for(int blockRow = 0; blockRow < blockM; ++blockRow){
+            packAPanel(ws, a, blockRow, blockN, n);
+            for (int col = 0; col < cols; ++col) {
+                fillAccWithZero(acc);
+                for (int i = 0; i < blockN; ++i) {
+                    fastBinaryBlockMatrixMul(ws->a[i], ws->b[col * blockN + i], acc, c_frag, signCmp, i == blockN - 1);
+                }
+                storeFragment(c_frag, c, blockRow, panelCol + col, k);
+            }
+        }
+    }
+}
+
+void binaryMatrixMul(const BinaryMatrix_t a, const BinaryMatrix_t b, Matrix_t result, const int m, const int n, const int k) {
+    binaryPlannerMatrixMul(a, b, result, m, n, k);
+}
+
+void fastBinaryMatrixMul(const BinaryMatrix_t a, const BinaryMatrix_t b, BinaryMatrix_t c, uint32_t signCmp, const int m, const int n, const int k){
+    fastBinaryPlannerMatrixMul(a, b, c, signCmp, m, n, k);
+}
+
+bool fastBinaryMatrixMulBTPU(const BTPUDevice_t* dev, const BinaryMatrix_t a, const BinaryMatrix_t b, BinaryMatrix_t c, uint32_t signCmp, const int m, const int n, const int k){
+    uint32_t blockM = m / BINARY_FRAG_SIZE;
+    uint32_t blockN = n / BINARY_FRAG_SIZE;
+    uint32_t blockK = k / BINARY_FRAG_SIZE;
+    uint32_t oMemStartAddr = blockM * blockN;
+    if(oMemStartAddr + blockM * blockK > BTPU_MAX_BLOCK_COUNT || blockN * blockK > BTPU_MAX_BLOCK_COUNT){
+        return false;
+    }
+    loadBinaryMatrixToFragments(a, dev->io0Memory, m, n);
+    loadBinaryMatrixToFragments(b, dev->wMemory, n, k);
+    btpuSetBlocks(dev->regs, blockM, blockN, blockK);
+    btpuSetAddrs(dev->regs, 0, 0, oMemStartAddr);
+    if(!btpuDeviceStart(dev, signCmp, true, true, BTPU_USE_MEMORY_0_CONFIG)){
+        return false;
+    }
+    if(!btpuDeviceWait(dev)){
+        return false;
+    }
+    storeFramentsToBinaryMatrix(dev->io1Memory + oMemStartAddr, c, m, k);
+    return true;
+}
+
 void binarizeMatrix(Matrix_t mat, BinaryMatrix_t bMat, uint32_t signCmp, uint32_t m, uint32_t n){
     for (int i = 0; i < m; ++i){
         for (int j = 0; j < n; ++j){
@@ -270,6 +411,7 @@ void storeFramentsToBinaryMatrix(const BinaryFragment_t src[], BinaryMatrix_t ma
 }
 
 void btpuSetBlocks(BTPURegFile_t* inst, const uint32_t m, const uint32_t n, const uint32_t k){
+#if defined(__riscv)
     // inst->mSize = m;
     // inst->nSize = n;
     // inst->kSize = k;
@@ -278,6 +420,12 @@ void btpuSetBlocks(BTPURegFile_t* inst, const uint32_t m, const uint32_t n, cons
         "sw a2, 20(a0)\n\t"
         "sw a3, 24(a0)\n\t"
     );
+#else
+    // Fuori dal RISC-V (es. istanze emulate su Linux)
+    inst->mSize = m;
+    inst->nSize = n;
+    inst->kSize = k;
+#endif
     // printf("[DEBUG] btpuSetBlocks called whit: M = %d, N = %d, K = %d\n", m, n, k);
     // printf("[DEBUG] inst:\n");
     // printf("     mSize: %d\n", inst->mSize);
@@ -320,4 +468,73 @@ bool btpuWaitBinaryMatrixMulWithCb(BTPURegFile_t* inst, BTPUCallBackFunct_t func
         }
     }
     return !inst->creg.reg.ERROR;
-}
\ No newline at end of file
+}
+
+bool btpuDeviceStart(const BTPUDevice_t* dev, const uint32_t signCmp, bool isBatched, bool clearAcc, uint8_t outputMemorySelect){
+    if(dev->emulatorAcc != NULL){
+        dev->regs->creg.reg.ERROR = 0;
+    }
+    if(!btpuStartBinaryMatrixMul(dev->regs, signCmp, isBatched, clearAcc, outputMemorySelect)){
+        return false;
+    }
+    if(dev->emulatorAcc != NULL){
+        dev->regs->creg.reg.BUSY = 1;
+    }
+    return true;
+}
+
+bool btpuDeviceDone(const BTPUDevice_t* dev){
+    if(dev->emulatorAcc != NULL){
+        btpuEmulatorRun(dev);
+    }
+    return !dev->regs->creg.reg.BUSY;
+}
+
+bool btpuDeviceWait(const BTPUDevice_t* dev){
+    while(!btpuDeviceDone(dev)){
+        // Wait for the BTPU to finish
+    }
+    return !dev->regs->creg.reg.ERROR;
+}
+
+void btpuEmulatorRun(const BTPUDevice_t* dev){
+    BTPURegFile_t* regs = dev->regs;
+    if(!regs->creg.reg.START){
+        return;
+    }
+    regs->creg.reg.ERROR = 0;
+    regs->creg.reg.BUSY = 1;
+    const uint32_t blockM = regs->creg.reg.BATCHED_MUL ? regs->mSize : 1;
+    const uint32_t blockN = regs->nSize;
+    const uint32_t blockK = regs->creg.reg.BATCHED_MUL ? regs->kSize : 1;
+    const uint32_t wStride = regs->kSize;
+    BinaryFragment_t* iMem = regs->creg.reg.OMEM_SEL ? dev->io0Memory : dev->io1Memory;
+    BinaryFragment_t* oMem = regs->creg.reg.OMEM_SEL ? dev->io1Memory : dev->io0Memory;
+    if((!regs->creg.reg.ACC_CLEAR && blockM * blockK > 1) ||
+       regs->wMemStartAddr + blockN * wStride > BTPU_MAX_BLOCK_COUNT ||
+       regs->iMemStartAddr + blockM * blockN > BTPU_MAX_BLOCK_COUNT ||
+       regs->oMemStartAddr + blockM * blockK > BTPU_MAX_BLOCK_COUNT){
+        regs->creg.reg.ERROR = 1;
+    }else{
+        BinaryFragment_t wT;
+        for(int row = 0; row < blockM; ++row){
+            for(int col = 0; col < blockK; ++col){
+                if(regs->creg.reg.ACC_CLEAR){
+                    fillAccWithZero(*dev->emulatorAcc);
+                }
+                for(int i = 0; i < blockN; ++i){
+                    transposeBinaryFragment(dev->wMemory[regs->wMemStartAddr + i * wStride + col], wT);
+                    binaryBlockMatrixMul(iMem[regs->iMemStartAddr + row * blockN + i], wT, *dev->emulatorAcc);
+                }
+                BinaryFragment_t* out = &oMem[regs->oMemStartAddr + row * blockK + col];
+                for(int r = 0; r < BINARY_FRAG_SIZE; ++r){
+                    for(int c = 0; c < BINARY_FRAG_SIZE; ++c){
+                        setBit(*out, r, c, (*dev->emulatorAcc)[r][c] > regs->signCmp, BINARY_FRAG_SIZE);
+                    }
+                }
+            }
+        }
+    }
+    regs->creg.reg.START = 0;
+    regs->creg.reg.BUSY = 0;
+}
@@ -0,0 +1,179 @@
+#include <BinaryMatMulPlanner.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+
+static BinaryPlannerTimer_t plannerTimer = NULL;
+static const BTPUDevice_t* plannerBTPU = NULL;
+static BinaryPanelWorkspace_t* plannerWorkspace = NULL;
+static const BinaryMatMulPlan_t* plannerTable = NULL;
+static uint32_t plannerTableCount = 0;
+static BinaryMatMulPlan_t plannerCache[BINARY_PLANNER_CACHE_SIZE];
+static uint32_t plannerCacheCount = 0;
+
+void binaryPlannerSetTimer(BinaryPlannerTimer_t timer){
+    plannerTimer = timer;
+}
+
+void binaryPlannerSetWorkspace(BinaryPanelWorkspace_t* ws){
+    plannerWorkspace = ws;
+}
+
+void binaryPlannerSetBTPU(const BTPUDevice_t* dev){
+    plannerBTPU = dev;
+}
+
+void binaryPlannerLoadTable(const BinaryMatMulPlan_t* table, uint32_t count){
+    plannerTable = table;
+    plannerTableCount = table ? count : 0;
+}
+
+void binaryPlannerClearCache(void){
+    plannerCacheCount = 0;
+}
+
+static bool planMatches(const BinaryMatMulPlan_t* plan, uint32_t m, uint32_t n, uint32_t k, bool binarized){
+    return plan->m == m && plan->n == n && plan->k == k && plan->binarized == binarized;
+}
+
+const BinaryMatMulPlan_t* binaryPlannerGetPlan(uint32_t m, uint32_t n, uint32_t k, bool binarized){
+    for(int i = 0; i < plannerTableCount; ++i){
+        if(planMatches(&plannerTable[i], m, n, k, binarized)){
+            return &plannerTable[i];
+        }
+    }
+    for(int i = 0; i < plannerCacheCount; ++i){
+        if(planMatches(&plannerCache[i], m, n, k, binarized)){
+            return &plannerCache[i];
+        }
+    }
+    return NULL;
+}
+
+uint32_t binaryPlannerExportTable(BinaryMatMulPlan_t* table, uint32_t maxCount){
+    uint32_t count = plannerCacheCount < maxCount ? plannerCacheCount : maxCount;
+    for(int i = 0; i < count; ++i){
+        table[i] = plannerCache[i];
+    }
+    return count;
+}
+
+static void cachePlan(const BinaryMatMulPlan_t* plan){
+    if(plannerCacheCount < BINARY_PLANNER_CACHE_SIZE){
+        plannerCache[plannerCacheCount++] = *plan;
+    }
+}
+
+/// Esegue il piano, restituisce false se la variante non e' applicabile (BTPU assente o memoria insufficiente)
+static bool runPlan(const BinaryMatMulPlan_t* plan, const BinaryMatrix_t a, const BinaryMatrix_t b, uint32_t* out, uint32_t signCmp){
+    uint32_t panelBlocks = 0;
+    switch(plan->kernel){
+        case BINARY_KERNEL_BTPU:
+            return plannerBTPU != NULL && plan->binarized &&
+                   fastBinaryMatrixMulBTPU(plannerBTPU, a, b, out, signCmp, plan->m, plan->n, plan->k);
+        case BINARY_KERNEL_PANEL:
+            panelBlocks = plan->panelBlocks;
+            break;
+        default:
+            break;
+    }
+    if(plan->binarized){
+        fastBinaryMatrixMulPanel(a, b, out, signCmp, plan->m, plan->n, plan->k, panelBlocks, plannerWorkspace);
+    }else{
+        binaryMatrixMulPanel(a, b, out, plan->m, plan->n, plan->k, panelBlocks, plannerWorkspace);
+    }
+    return true;
+}
+
+/*
+    Misura il piano candidato e lo tiene come migliore se piu' veloce.
+    Restituisce false se il candidato non e' stato eseguito: in quel caso out non contiene il suo risultato
+    (una BTPU che fallisce puo' lasciarvi quello di un candidato precedente o nessuno).
+*/
+static bool timeCandidate(BinaryMatMulPlan_t* candidate, BinaryMatMulPlan_t* best, uint64_t* bestTime,
+                          const BinaryMatrix_t a, const BinaryMatrix_t b, uint32_t* out, uint32_t signCmp){
+    uint64_t start = plannerTimer();
+    if(!runPlan(candidate, a, b, out, signCmp)){
+        return false;
+    }
+    uint64_t elapsed = plannerTimer() - start;
+    if(elapsed < *bestTime){
+        *bestTime = elapsed;
+        *best = *candidate;
+    }
+    return true;
+}
+
+/*
+    Esegue tutte le varianti candidate sugli operandi reali e memorizza la piu' veloce.
+    I pannelli vengono provati con dimensioni potenze di due fino alla capacita' dei buffer.
+*/
+static void tuneAndRun(BinaryMatMulPlan_t* plan, const BinaryMatrix_t a, const BinaryMatrix_t b, uint32_t* out, uint32_t signCmp){
+    const uint32_t blockN = plan->n / BINARY_FRAG_SIZE;
+    const uint32_t blockK = plan->k / BINARY_FRAG_SIZE;
+    BinaryMatMulPlan_t candidate = *plan;
+    BinaryMatMulPlan_t best = *plan;
+    uint64_t bestTime = UINT64_MAX;
+    bool lastRan = false;
+
+    candidate.kernel = BINARY_KERNEL_UNPACKED;
+    candidate.panelBlocks = 0;
+    lastRan = timeCandidate(&candidate, &best, &bestTime, a, b, out, signCmp);
+
+    if(plannerWorkspace != NULL && blockN > 0 && blockN <= BINARY_MATMUL_A_PANEL_FRAGS){
+        uint32_t maxBlocks = BINARY_MATMUL_B_PANEL_FRAGS / blockN;
+        if(maxBlocks > blockK){
+            maxBlocks = blockK;
+        }
+        candidate.kernel = BINARY_KERNEL_PANEL;
+        for(uint32_t panelBlocks = 1; panelBlocks <= maxBlocks; panelBlocks *= 2){
+            candidate.panelBlocks = panelBlocks;
+            lastRan = timeCandidate(&candidate, &best, &bestTime, a, b, out, signCmp);
+        }
+        if(maxBlocks > 0 && (maxBlocks & (maxBlocks - 1)) != 0){
+            candidate.panelBlocks = maxBlocks;
+            lastRan = timeCandidate(&candidate, &best, &bestTime, a, b, out, signCmp);
+        }
+    }
+
+    if(plan->binarized && plannerBTPU != NULL){
+        candidate.kernel = BINARY_KERNEL_BTPU;
+        candidate.panelBlocks = 0;
+        lastRan = timeCandidate(&candidate, &best, &bestTime, a, b, out, signCmp);
+    }
+
+    cachePlan(&best);
+    // out contiene il risultato solo se l'ultimo candidato e' stato eseguito, altrimenti si riesegue il migliore
+    if(!lastRan){
+        runPlan(&best, a, b, out, signCmp);
+    }
+}
+
+static void plannedMatrixMul(const BinaryMatrix_t a, const BinaryMatrix_t b, uint32_t* out, uint32_t signCmp,
+                             uint32_t m, uint32_t n, uint32_t k, bool binarized){
+    const BinaryMatMulPlan_t* cached = binaryPlannerGetPlan(m, n, k, binarized);
+    if(cached != NULL && runPlan(cached, a, b, out, signCmp)){
+        return;
+    }
+
+    BinaryMatMulPlan_t plan = {m, n, k, binarized, BINARY_KERNEL_PANEL, binaryMatMulGetPanelBlocks(n, k)};
+    if(plan.panelBlocks == 0 || plannerWorkspace == NULL){
+        plan.panelBlocks = 0;
+        plan.kernel = BINARY_KERNEL_UNPACKED;
+    }
+    // Con la cache piena non si fa tuning: il piano non potrebbe essere memorizzato e verrebbe rimisurato ad ogni chiamata
+    if(cached == NULL && plannerTimer != NULL && plannerCacheCount < BINARY_PLANNER_CACHE_SIZE){
+        tuneAndRun(&plan, a, b, out, signCmp);
+        return;
+    }
+    runPlan(&plan, a, b, out, signCmp);
+}
+
+void binaryPlannerMatrixMul(const BinaryMatrix_t a, const BinaryMatrix_t b, Matrix_t result, const int m, const int n, const int k){
+    plannedMatrixMul(a, b, result, 0, m, n, k, false);
+}
+
+void fastBinaryPlannerMatrixMul(const BinaryMatrix_t a, const BinaryMatrix_t b, BinaryMatrix_t c, uint32_t signCmp, const int m, const int n, const int k){
+    plannedMatrixMul(a, b, c, signCmp, m, n, k, true);
+}
@@ -0,0 +1,71 @@
+#include <BinarySemiringMatMul.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+
+/*
+    Costruisce le tabelle del blocco bFrag: ws->tables[t][idx] e' la somma delle righe 8t + j con il bit
+    (7 - j) di idx a 1. Ogni voce costa una sola operazione: si aggiunge una riga a una voce gia' calcolata.
+*/
+static void buildTables(const BinaryFragment_t bFrag, BinarySemiring_t semiring, BinaryM4RWorkspace_t* ws){
+    for(int t = 0; t < BINARY_M4R_TABLES; ++t){
+        uint32_t* table = ws->tables[t];
+        table[0] = 0;
+        for(int p = 0; p < BINARY_M4R_CHUNK_BITS; ++p){
+            const uint32_t bit = 1u << p;
+            const uint32_t row = bFrag[t * BINARY_M4R_CHUNK_BITS + BINARY_M4R_CHUNK_BITS - 1 - p];
+            for(uint32_t idx = 0; idx < bit; ++idx){
+                table[bit + idx] = semiring == BINARY_SEMIRING_GF2 ? table[idx] ^ row : table[idx] | row;
+            }
+        }
+    }
+}
+
+void binarySemiringMatrixMul(const BinaryMatrix_t a, const BinaryMatrix_t b, BinaryMatrix_t c, BinarySemiring_t semiring, const int m, const int n, const int k, BinaryM4RWorkspace_t* ws){
+    const uint32_t blockM = m / BINARY_FRAG_SIZE;
+    const uint32_t blockN = n / BINARY_FRAG_SIZE;
+    const uint32_t blockK = k / BINARY_FRAG_SIZE;
+    BinaryFragment_t aFrag;
+    BinaryFragment_t bFrag;
+    BinaryFragment_t cFrag;
+
+    for(int blockCol = 0; blockCol < blockK; ++blockCol){
+        for(int i = 0; i < blockN; ++i){
+            // Le tabelle del blocco (i, blockCol) vengono riusate da tutte le righe di A
+            loadFragment(bFrag, b, i, blockCol, k);
+            buildTables(bFrag, semiring, ws);
+            for(int blockRow = 0; blockRow < blockM; ++blockRow){
+                loadFragment(aFrag, a, blockRow, i, n);
+                if(i == 0){
+                    for(int row = 0; row < BINARY_FRAG_SIZE; ++row){
+                        cFrag[row] = 0;
+                    }
+                }else{
+                    loadFragment(cFrag, c, blockRow, blockCol, k);
+                }
+                for(int row = 0; row < BINARY_FRAG_SIZE; ++row){
+                    const uint32_t word = aFrag[row];
+                    const uint32_t t0 = ws->tables[0][word >> 24];
+                    const uint32_t t1 = ws->tables[1][(word >> 16) & 0xFF];
+                    const uint32_t t2 = ws->tables[2][(word >> 8) & 0xFF];
+                    const uint32_t t3 = ws->tables[3][word & 0xFF];
+                    if(semiring == BINARY_SEMIRING_GF2){
+                        cFrag[row] ^= t0 ^ t1 ^ t2 ^ t3;
+                    }else{
+                        cFrag[row] |= t0 | t1 | t2 | t3;
+                    }
+                }
+                storeFragment(cFrag, c, blockRow, blockCol, k);
+            }
+        }
+    }
+}
+
+void gf2MatrixMul(const BinaryMatrix_t a, const BinaryMatrix_t b, BinaryMatrix_t c, const int m, const int n, const int k, BinaryM4RWorkspace_t* ws){
+    binarySemiringMatrixMul(a, b, c, BINARY_SEMIRING_GF2, m, n, k, ws);
+}
+
+void booleanMatrixMul(const BinaryMatrix_t a, const BinaryMatrix_t b, BinaryMatrix_t c, const int m, const int n, const int k, BinaryM4RWorkspace_t* ws){
+    binarySemiringMatrixMul(a, b, c, BINARY_SEMIRING_BOOLEAN, m, n, k, ws);
+}
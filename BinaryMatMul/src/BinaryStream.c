@@ -0,0 +1,65 @@
+#include <BinaryStream.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+
+void binaryStreamInit(BinaryStream_t* stream, BinaryStreamCallback_t callback, void* ctx){
+    stream->layerCount = 0;
+    stream->callback = callback;
+    stream->ctx = ctx;
+    stream->strips = 0;
+}
+
+bool binaryStreamAddLayer(BinaryStream_t* stream, const BinaryWeights_t* w, uint32_t signCmp, bool raw){
+    if(stream->layerCount == BINARY_STREAM_MAX_LAYERS){
+        return false;
+    }
+    if(stream->layerCount > 0){
+        const BinaryStreamLayer_t* prev = &stream->layers[stream->layerCount - 1];
+        if(prev->raw || prev->w->k != w->n){
+            return false;
+        }
+    }
+    // Uscita raw: un valore per elemento, altrimenti un bit
+    const uint32_t words = raw ? BINARY_FRAG_SIZE * w->k : BINARY_FRAG_SIZE * (w->k / 32);
+    uint32_t* strip = (uint32_t*)malloc(words * sizeof(uint32_t));
+    if(!strip){
+        return false;
+    }
+    BinaryStreamLayer_t* layer = &stream->layers[stream->layerCount++];
+    layer->w = w;
+    layer->signCmp = signCmp;
+    layer->raw = raw;
+    layer->strip = strip;
+    return true;
+}
+
+bool binaryStreamPush(BinaryStream_t* stream, const BinaryMatrix_t strip, uint32_t rows){
+    if(stream->layerCount == 0 || rows == 0 || rows > BINARY_FRAG_SIZE){
+        return false;
+    }
+    BinaryMatrix_t in = strip;
+    for(int l = 0; l < stream->layerCount; ++l){
+        BinaryStreamLayer_t* layer = &stream->layers[l];
+        if(layer->raw){
+            binaryMatrixMulPrepared(in, layer->w, layer->strip, BINARY_FRAG_SIZE);
+        }else{
+            fastBinaryMatrixMulPrepared(in, layer->w, layer->strip, layer->signCmp, BINARY_FRAG_SIZE);
+        }
+        in = layer->strip;
+    }
+    if(stream->callback != NULL){
+        stream->callback(in, rows, stream->ctx);
+    }
+    stream->strips++;
+    return true;
+}
+
+void binaryStreamFree(BinaryStream_t* stream){
+    for(int l = 0; l < stream->layerCount; ++l){
+        free(stream->layers[l].strip);
+        stream->layers[l].strip = NULL;
+    }
+    stream->layerCount = 0;
+}
@@ -0,0 +1,99 @@
+/*!
+    @file       batchedMatMulTest.c
+    @brief      Test su host delle moltiplicazioni batched con pesi preparati.
+    @details    Confronta binaryMatrixMulBatched e fastBinaryMatrixMulBatched con il kernel software, sia con pesi
+                condivisi sia con pesi diversi per ogni input (anche con n e k diversi), e verifica che un batch vuoto
+                venga rifiutato.
+
+    @author     Alan Masutti  (@alanmasu)
+    @date       18/10/2026
+*/
+
+#include <BinaryMatMul.h>
+#include <BinaryBatchedMatMul.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define BATCH       2
+#define M           64
+#define MAX_N       128
+#define MAX_K       96
+#define SIGN_CMP    40
+
+static const uint32_t itemN[BATCH] = {64, 128};
+static const uint32_t itemK[BATCH] = {32, 96};
+
+static uint32_t a[BATCH][M * MAX_N / 32];
+static uint32_t b[BATCH][MAX_N * MAX_K / 32];
+static uint32_t result[BATCH][M * MAX_K];
+static uint32_t expected[M * MAX_K];
+static uint32_t c[BATCH][M * MAX_K / 32];
+static uint32_t expectedC[M * MAX_K / 32];
+
+static int failures = 0;
+
+static void check(bool condition, const char* what){
+    if(!condition){
+        printf("[FAIL] %s\n", what);
+        ++failures;
+    }
+}
+
+static void fillRandom(uint32_t* mat, uint32_t words, uint32_t* seed){
+    for(int i = 0; i < words; ++i){
+        *seed = *seed * 1664525u + 1013904223u;
+        mat[i] = *seed;
+    }
+}
+
+/// Ogni input confrontato con il kernel software sulle proprie dimensioni
+static void checkItems(const BinaryWeights_t w[], uint32_t wCount, const char* what){
+    const BinaryMatrix_t aItems[BATCH] = {a[0], a[1]};
+    memset(result, 0, sizeof(result));
+    memset(c, 0, sizeof(c));
+    check(binaryMatrixMulBatched(aItems, w, wCount, result[0], M * MAX_K, BATCH, M), what);
+    check(fastBinaryMatrixMulBatched(aItems, w, wCount, c[0], M * MAX_K / 32, SIGN_CMP, BATCH, M), what);
+    for(int item = 0; item < BATCH; ++item){
+        const BinaryWeights_t* wi = &w[wCount == 1 ? 0 : item];
+        const int n = wi->n;
+        const int k = wi->k;
+        memset(expected, 0, sizeof(expected));
+        binaryMatrixMulPanel(a[item], b[wCount == 1 ? 0 : item], expected, M, n, k, 0, NULL);
+        fastBinaryMatrixMulPanel(a[item], b[wCount == 1 ? 0 : item], expectedC, SIGN_CMP, M, n, k, 0, NULL);
+        check(memcmp(result[item], expected, M * k * sizeof(uint32_t)) == 0, what);
+        check(memcmp(c[item], expectedC, M * k / 8) == 0, what);
+    }
+}
+
+int main(){
+    uint32_t seed = 5;
+    BinaryWeights_t w[BATCH];
+    for(int item = 0; item < BATCH; ++item){
+        fillRandom(a[item], M * itemN[item] / 32, &seed);
+        fillRandom(b[item], itemN[item] * itemK[item] / 32, &seed);
+        check(prepareBinaryWeights(&w[item], b[item], itemN[item], itemK[item]), "prepare weights");
+    }
+
+    // Pesi diversi per ogni input, con k minore sul primo input
+    checkItems(w, BATCH, "per-item weights, different k");
+
+    // Pesi condivisi: entrambi gli input usano le dimensioni di w[0]
+    fillRandom(a[1], M * itemN[0] / 32, &seed);
+    checkItems(w, 1, "shared weights");
+
+    const BinaryMatrix_t aItems[BATCH] = {a[0], a[1]};
+    check(!binaryMatrixMulBatched(aItems, w, 0, result[0], M * MAX_K, 0, M), "empty batch rejected");
+    check(!fastBinaryMatrixMulBatched(aItems, w, 0, c[0], M * MAX_K / 32, SIGN_CMP, 0, M), "empty batch rejected (fast)");
+    check(!binaryMatrixMulBatched(aItems, w, 3, result[0], M * MAX_K, BATCH, M), "invalid wCount rejected");
+
+    for(int item = 0; item < BATCH; ++item){
+        freeBinaryWeights(&w[item]);
+    }
+
+    if(failures == 0){
+        printf("All tests passed\n");
+    }
+    return failures == 0 ? 0 : 1;
+}
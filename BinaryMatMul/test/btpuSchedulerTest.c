@@ -0,0 +1,230 @@
+/*!
+    @file       btpuSchedulerTest.c
+    @brief      Test su host dello scheduler multi-BTPU con istanze emulate.
+    @details    Confronta il risultato dello scheduler con il kernel software, verifica la residenza dei pesi, la
+                divisione per blocchi colonna di una striscia da 32 righe, l'accumulo tra job con ACC_CLEAR a 0 e il
+                recupero di un'istanza dopo un job in errore.
+                Verifica anche fastBinaryMatrixMulBTPU e il planner con una BTPU emulata come candidato.
+
+    @author     Alan Masutti  (@alanmasu)
+    @date       18/10/2026
+*/
+
+#include <BinaryMatMul.h>
+#include <BinaryBTPUScheduler.h>
+#include <BinaryMatMulPlanner.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define DEVICES 3
+#define M 256
+#define N 128
+#define K 96
+
+static BTPURegFile_t    regs[DEVICES];
+static BinaryFragment_t wMemory[DEVICES][BTPU_MAX_BLOCK_COUNT];
+static BinaryFragment_t io0Memory[DEVICES][BTPU_MAX_BLOCK_COUNT];
+static BinaryFragment_t io1Memory[DEVICES][BTPU_MAX_BLOCK_COUNT];
+static BinaryAcc_t      emulatorAcc[DEVICES];
+
+static const BTPUDevice_t devices[DEVICES] = {
+    { &regs[0], wMemory[0], io0Memory[0], io1Memory[0], &emulatorAcc[0] },
+    { &regs[1], wMemory[1], io0Memory[1], io1Memory[1], &emulatorAcc[1] },
+    { &regs[2], wMemory[2], io0Memory[2], io1Memory[2], &emulatorAcc[2] },
+};
+
+static uint32_t a[M * N / 32];
+static uint32_t b[N * K / 32];
+static uint32_t c[M * K / 32];
+static uint32_t expected[M * K / 32];
+
+static int failures = 0;
+
+static void check(bool condition, const char* what){
+    if(!condition){
+        printf("[FAIL] %s\n", what);
+        ++failures;
+    }
+}
+
+static void fillRandom(uint32_t* mat, uint32_t words, uint32_t* seed){
+    for(int i = 0; i < words; ++i){
+        *seed = *seed * 1664525u + 1013904223u;
+        mat[i] = *seed;
+    }
+}
+
+/// Lo scheduler deve dare lo stesso risultato del kernel software e non ricaricare pesi gia' residenti
+static void testScheduler(void){
+    BTPUScheduler_t sched;
+    check(btpuSchedulerInit(&sched, devices, DEVICES), "init scheduler");
+    fastBinaryMatrixMulPanel(a, b, expected, N / 2, M, N, K, 0, NULL);
+
+    memset(c, 0, sizeof(c));
+    check(btpuSchedulerMatrixMul(&sched, a, b, c, N / 2, M, N, K), "scheduler matmul");
+    check(memcmp(c, expected, sizeof(c)) == 0, "scheduler result");
+    for(int d = 0; d < DEVICES; ++d){
+        check(sched.state[d].completedJobs > 0, "every device receives jobs");
+    }
+
+    // Con i pesi residenti B non viene ricaricata: modificarla senza invalidare lascia il risultato invariato
+    for(int i = 0; i < N * K / 32; ++i){
+        b[i] = ~b[i];
+    }
+    memset(c, 0, sizeof(c));
+    check(btpuSchedulerMatrixMul(&sched, a, b, c, N / 2, M, N, K), "scheduler matmul, resident weights");
+    check(memcmp(c, expected, sizeof(c)) == 0, "weights not reloaded");
+
+    btpuSchedulerInvalidateWeights(&sched);
+    fastBinaryMatrixMulPanel(a, b, expected, N / 2, M, N, K, 0, NULL);
+    memset(c, 0, sizeof(c));
+    check(btpuSchedulerMatrixMul(&sched, a, b, c, N / 2, M, N, K), "scheduler matmul, invalidated weights");
+    check(memcmp(c, expected, sizeof(c)) == 0, "weights reloaded after invalidation");
+
+    for(int i = 0; i < N * K / 32; ++i){
+        b[i] = ~b[i];
+    }
+    fastBinaryMatrixMulPanel(a, b, expected, N / 2, M, N, K, 0, NULL);
+}
+
+/// Una striscia da una sola riga di blocchi deve essere divisa per blocchi colonna su tutte le istanze
+static void testStrip(void){
+    const uint32_t stripN = 512;
+    const uint32_t stripK = 1024;
+    uint32_t* stripA = (uint32_t*)malloc(BINARY_FRAG_SIZE * stripN / 8);
+    uint32_t* stripB = (uint32_t*)malloc(stripN * stripK / 8);
+    uint32_t* stripC = (uint32_t*)calloc(BINARY_FRAG_SIZE * stripK / 32, sizeof(uint32_t));
+    uint32_t* stripExpected = (uint32_t*)calloc(BINARY_FRAG_SIZE * stripK / 32, sizeof(uint32_t));
+    uint32_t seed = 17;
+    fillRandom(stripA, BINARY_FRAG_SIZE * stripN / 32, &seed);
+    fillRandom(stripB, stripN * stripK / 32, &seed);
+    fastBinaryMatrixMulPanel(stripA, stripB, stripExpected, stripN / 2, BINARY_FRAG_SIZE, stripN, stripK, 0, NULL);
+
+    BTPUScheduler_t sched;
+    btpuSchedulerInit(&sched, devices, DEVICES);
+    check(btpuSchedulerMatrixMul(&sched, stripA, stripB, stripC, stripN / 2, BINARY_FRAG_SIZE, stripN, stripK), "strip matmul");
+    check(memcmp(stripC, stripExpected, BINARY_FRAG_SIZE * stripK / 8) == 0, "strip result");
+    for(int d = 0; d < DEVICES; ++d){
+        check(sched.state[d].completedJobs > 0, "every device receives strip jobs");
+    }
+
+    // Seconda striscia con gli stessi pesi: nessun ricaricamento, le istanze possono eseguire qualsiasi colonna
+    fillRandom(stripA, BINARY_FRAG_SIZE * stripN / 32, &seed);
+    fastBinaryMatrixMulPanel(stripA, stripB, stripExpected, stripN / 2, BINARY_FRAG_SIZE, stripN, stripK, 0, NULL);
+    memset(stripC, 0, BINARY_FRAG_SIZE * stripK / 8);
+    check(btpuSchedulerMatrixMul(&sched, stripA, stripB, stripC, stripN / 2, BINARY_FRAG_SIZE, stripN, stripK) &&
+          memcmp(stripC, stripExpected, BINARY_FRAG_SIZE * stripK / 8) == 0, "second strip with resident weights");
+
+    free(stripA);
+    free(stripB);
+    free(stripC);
+    free(stripExpected);
+}
+
+/// Un job con ACC_CLEAR a 0 su un solo blocco di uscita continua ad accumulare
+static void testAccClear(void){
+    const BTPUDevice_t* dev = &devices[0];
+    BinaryFragment_t bT;
+    BinaryFragment_t expectedFrag;
+    BinaryAcc_t acc;
+
+    loadFragment(dev->io0Memory[0], a, 0, 0, N);
+    loadFragment(dev->wMemory[0], b, 0, 0, K);
+    transposeBinaryFragment(dev->wMemory[0], bT);
+    fillAccWithZero(acc);
+    binaryBlockMatrixMul(dev->io0Memory[0], bT, acc);
+    binaryBlockMatrixMul(dev->io0Memory[0], bT, acc);
+    for(int r = 0; r < BINARY_FRAG_SIZE; ++r){
+        for(int col = 0; col < BINARY_FRAG_SIZE; ++col){
+            setBit(expectedFrag, r, col, acc[r][col] > 40, BINARY_FRAG_SIZE);
+        }
+    }
+
+    btpuSetBlocks(dev->regs, 1, 1, 1);
+    btpuSetAddrs(dev->regs, 0, 0, 1);
+    check(btpuDeviceStart(dev, 40, true, true, BTPU_USE_MEMORY_0_CONFIG) && btpuDeviceWait(dev), "first job");
+    check(btpuDeviceStart(dev, 40, true, false, BTPU_USE_MEMORY_0_CONFIG) && btpuDeviceWait(dev), "accumulating job");
+    check(memcmp(dev->io1Memory[1], expectedFrag, sizeof(BinaryFragment_t)) == 0, "accumulated result");
+
+    // Accumulo su piu' blocchi di uscita: comportamento non modellato, segnalato come errore
+    btpuSetBlocks(dev->regs, 2, 1, 1);
+    check(btpuDeviceStart(dev, 40, true, false, BTPU_USE_MEMORY_0_CONFIG) && !btpuDeviceWait(dev), "multi-tile accumulation rejected");
+}
+
+/// Dopo un job fuori dalle memorie l'istanza deve poter eseguire il job successivo
+static void testErrorRecovery(void){
+    const BTPUDevice_t* dev = &devices[1];
+    btpuSetBlocks(dev->regs, 1, 1, 1);
+    btpuSetAddrs(dev->regs, 0, 0, BTPU_MAX_BLOCK_COUNT);
+    check(btpuDeviceStart(dev, 0, true, true, BTPU_USE_MEMORY_0_CONFIG) && !btpuDeviceWait(dev), "out of range job fails");
+    btpuSetAddrs(dev->regs, 0, 0, 1);
+    check(btpuDeviceStart(dev, 0, true, true, BTPU_USE_MEMORY_0_CONFIG) && btpuDeviceWait(dev), "next job succeeds");
+
+    BTPUScheduler_t sched;
+    btpuSchedulerInit(&sched, devices, DEVICES);
+    memset(c, 0, sizeof(c));
+    check(btpuSchedulerMatrixMul(&sched, a, b, c, N / 2, M, N, K) && memcmp(c, expected, sizeof(c)) == 0, "scheduler after error");
+}
+
+static uint64_t fakeTime = 0;
+
+/// Timer fittizio: ogni candidato misura lo stesso tempo, quindi vince il primo
+static uint64_t fakeTimer(void){
+    return fakeTime++;
+}
+
+/// fastBinaryMatrixMulBTPU deve usare le memorie dell'istanza passata, e il planner deve restituire il risultato
+/// corretto anche quando il candidato BTPU, misurato per ultimo, fallisce
+static void testSingleDevice(void){
+    memset(c, 0, sizeof(c));
+    check(fastBinaryMatrixMulBTPU(&devices[2], a, b, c, N / 2, M, N, K), "single device matmul");
+    check(memcmp(c, expected, sizeof(c)) == 0, "single device result");
+
+    // blockN * blockK > BTPU_MAX_BLOCK_COUNT: la BTPU non puo' eseguire la forma
+    const uint32_t bigN = 33 * BINARY_FRAG_SIZE;
+    const uint32_t bigK = 32 * BINARY_FRAG_SIZE;
+    uint32_t* bigA = (uint32_t*)calloc(BINARY_FRAG_SIZE * bigN / 32, sizeof(uint32_t));
+    uint32_t* bigB = (uint32_t*)calloc(bigN * bigK / 32, sizeof(uint32_t));
+    uint32_t* bigC = (uint32_t*)calloc(BINARY_FRAG_SIZE * bigK / 32, sizeof(uint32_t));
+    uint32_t* bigExpected = (uint32_t*)calloc(BINARY_FRAG_SIZE * bigK / 32, sizeof(uint32_t));
+    uint32_t seed = 3;
+    fillRandom(bigA, BINARY_FRAG_SIZE * bigN / 32, &seed);
+    fillRandom(bigB, bigN * bigK / 32, &seed);
+    fastBinaryMatrixMulPanel(bigA, bigB, bigExpected, bigN / 2, BINARY_FRAG_SIZE, bigN, bigK, 0, NULL);
+
+    binaryPlannerClearCache();
+    binaryPlannerSetTimer(fakeTimer);
+    binaryPlannerSetBTPU(&devices[2]);
+    memset(c, 0, sizeof(c));
+    fastBinaryMatrixMul(a, b, c, N / 2, M, N, K);
+    check(memcmp(c, expected, sizeof(c)) == 0, "planner result with BTPU candidate");
+    memset(bigC, 0xFF, BINARY_FRAG_SIZE * bigK / 8);
+    fastBinaryMatrixMul(bigA, bigB, bigC, bigN / 2, BINARY_FRAG_SIZE, bigN, bigK);
+    check(memcmp(bigC, bigExpected, BINARY_FRAG_SIZE * bigK / 8) == 0, "planner result when the BTPU candidate fails");
+    binaryPlannerSetBTPU(NULL);
+    binaryPlannerSetTimer(NULL);
+
+    free(bigA);
+    free(bigB);
+    free(bigC);
+    free(bigExpected);
+}
+
+int main(){
+    uint32_t seed = 1;
+    fillRandom(a, M * N / 32, &seed);
+    fillRandom(b, N * K / 32, &seed);
+
+    testScheduler();
+    testStrip();
+    testAccClear();
+    testErrorRecovery();
+    testSingleDevice();
+
+    if(failures == 0){
+        printf("All tests passed\n");
+    }
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,141 @@
+/*!
+    @file       conv2dTest.c
+    @brief      Test su host di binaryConv2d contro un riferimento naive in aritmetica +-1.
+    @details    Il riferimento somma x * w su tutta la finestra, con x = 0 nel padding e nella coda dell'ultima parola
+                del filtro (mezzo match nel conteggio XNOR), poi applica la soglia e il max-pool con un OR. Le
+                configurazioni coprono canali non multipli di 32, padding, stride e pool, e riusano un solo workspace.
+
+    @author     Alan Masutti  (@alanmasu)
+    @date       18/10/2026
+*/
+
+#include <BinaryMatMul.h>
+#include <BinaryConv2d.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static int failures = 0;
+
+/// Bit pos dello stream (MSB first), come in getBit
+static int streamBit(const uint32_t* stream, uint32_t pos){
+    return (stream[pos / 32] >> (31 - pos % 32)) & 1;
+}
+
+static void fillRandom(uint32_t* mat, uint32_t words, uint32_t* seed){
+    for(int i = 0; i < words; ++i){
+        *seed = *seed * 1664525u + 1013904223u;
+        mat[i] = *seed;
+    }
+}
+
+/// Bit di uscita della convoluzione (prima del pool) nel pixel (oy, ox) e canale ch
+static int naiveConvBit(const uint32_t* input, const uint32_t* filters, const BinaryConv2dParams_t* p,
+                        uint32_t oy, uint32_t ox, uint32_t ch, uint32_t signCmp){
+    const uint32_t filterWords = binaryConv2dFilterWords(p);
+    const uint32_t* filter = filters + ch * filterWords;
+    int32_t dot = 0;
+    for(int ky = 0; ky < p->kH; ++ky){
+        for(int kx = 0; kx < p->kW; ++kx){
+            const int32_t iy = (int32_t)(oy * p->stride + ky) - (int32_t)p->pad;
+            const int32_t ix = (int32_t)(ox * p->stride + kx) - (int32_t)p->pad;
+            if(iy < 0 || iy >= (int32_t)p->inH || ix < 0 || ix >= (int32_t)p->inW){
+                continue;
+            }
+            for(int c = 0; c < p->inC; ++c){
+                const int32_t x = 2 * streamBit(input, (iy * p->inW + ix) * p->inC + c) - 1;
+                const int32_t w = 2 * streamBit(filter, (ky * p->kW + kx) * p->inC + c) - 1;
+                dot += x * w;
+            }
+        }
+    }
+    // signCmp e' riferito a 32 * filterWords bit: match = (dot + 32 * filterWords) / 2
+    return dot + 32 * (int32_t)filterWords > 2 * (int32_t)signCmp;
+}
+
+static void testConfig(const BinaryConv2dParams_t* p, int32_t signOffset, BinaryConv2dWorkspace_t* ws, uint32_t* seed){
+    const uint32_t convH = (p->inH + 2 * p->pad - p->kH) / p->stride + 1;
+    const uint32_t convW = (p->inW + 2 * p->pad - p->kW) / p->stride + 1;
+    const uint32_t filterWords = binaryConv2dFilterWords(p);
+    const uint32_t outWords = p->outC / 32;
+    const uint32_t signCmp = 16 * filterWords + signOffset;
+    uint32_t outH;
+    uint32_t outW;
+    binaryConv2dOutputSize(p, &outH, &outW);
+
+    const uint32_t inWords = (p->inH * p->inW * p->inC + 31) / 32 + 1;
+    uint32_t* input = (uint32_t*)calloc(inWords, sizeof(uint32_t));
+    uint32_t* filters = (uint32_t*)calloc(p->outC * filterWords, sizeof(uint32_t));
+    uint32_t* output = (uint32_t*)calloc(convH * convW * outWords, sizeof(uint32_t));
+    fillRandom(input, inWords, seed);
+    fillRandom(filters, p->outC * filterWords, seed);
+
+    binaryConv2d(input, filters, output, signCmp, p, ws);
+
+    bool ok = true;
+    for(int oy = 0; oy < outH && ok; ++oy){
+        for(int ox = 0; ox < outW && ok; ++ox){
+            for(int ch = 0; ch < p->outC && ok; ++ch){
+                int expected = 0;
+                if(p->poolSize > 1){
+                    for(int dy = 0; dy < p->poolSize; ++dy){
+                        for(int dx = 0; dx < p->poolSize; ++dx){
+                            expected |= naiveConvBit(input, filters, p, oy * p->poolSize + dy, ox * p->poolSize + dx, ch, signCmp);
+                        }
+                    }
+                }else{
+                    expected = naiveConvBit(input, filters, p, oy, ox, ch, signCmp);
+                }
+                ok = getBit(output, oy * outW + ox, ch, p->outC) == expected;
+            }
+        }
+    }
+    if(!ok){
+        printf("[FAIL] inC = %u, k = %ux%u, stride = %u, pad = %u, pool = %u\n", p->inC, p->kH, p->kW, p->stride, p->pad, p->poolSize);
+        ++failures;
+    }
+    free(input);
+    free(filters);
+    free(output);
+}
+
+int main(){
+    uint32_t seed = 9;
+    const BinaryConv2dParams_t configs[] = {
+        // inH, inW, inC, outC, kH, kW, stride, pad, poolSize
+        {  9, 11,  3, 32, 3, 3, 1, 1, 0},
+        { 12, 12, 20, 64, 3, 3, 1, 1, 2},
+        { 10,  7, 32, 32, 3, 3, 2, 0, 0},
+        { 13, 10, 48, 32, 5, 5, 2, 2, 0},
+        { 16, 16,  1, 32, 3, 3, 1, 2, 3},
+        {  8,  8, 64, 64, 1, 1, 1, 0, 2},
+    };
+    const uint32_t count = sizeof(configs) / sizeof(configs[0]);
+
+    // Un solo workspace, dimensionato sul filtro piu' grande
+    BinaryConv2dWorkspace_t ws;
+    const BinaryConv2dParams_t* largest = &configs[0];
+    for(int i = 1; i < count; ++i){
+        if(binaryConv2dFilterWords(&configs[i]) > binaryConv2dFilterWords(largest)){
+            largest = &configs[i];
+        }
+    }
+    if(!binaryConv2dAllocWorkspace(&ws, largest)){
+        printf("[FAIL] workspace allocation\n");
+        return 1;
+    }
+
+    const int32_t signOffsets[] = {0, 5, -7};
+    for(int i = 0; i < count; ++i){
+        for(int s = 0; s < sizeof(signOffsets) / sizeof(signOffsets[0]); ++s){
+            testConfig(&configs[i], signOffsets[s], &ws, &seed);
+        }
+    }
+    binaryConv2dFreeWorkspace(&ws);
+
+    if(failures == 0){
+        printf("All tests passed\n");
+    }
+    return failures == 0 ? 0 : 1;
+}
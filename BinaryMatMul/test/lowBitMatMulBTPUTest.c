@@ -0,0 +1,80 @@
+/*!
+    @file       lowBitMatMulBTPUTest.c
+    @brief      Test su host di lowBitMatrixMulBTPU con un'istanza BTPU emulata.
+    @details    Confronta il percorso BTPU con fastLowBitMatrixMul per diverse larghezze dei plane e soglie,
+                compresa una soglia sotto il prodotto minimo (uscita tutta a 1).
+
+    @author     Alan Masutti  (@alanmasu)
+    @date       18/10/2026
+*/
+
+#include <BinaryMatMul.h>
+#include <BinaryLowBitMatMul.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define M 64
+#define N 96
+#define K 64
+
+static BTPURegFile_t    regs;
+static BinaryFragment_t wMemory[BTPU_MAX_BLOCK_COUNT];
+static BinaryFragment_t io0Memory[BTPU_MAX_BLOCK_COUNT];
+static BinaryFragment_t io1Memory[BTPU_MAX_BLOCK_COUNT];
+static BinaryAcc_t      emulatorAcc;
+
+static const BTPUDevice_t device = { &regs, wMemory, io0Memory, io1Memory, &emulatorAcc };
+
+static uint8_t  codesA[M * N];
+static uint8_t  codesB[N * K];
+static uint32_t c[M * K / 32];
+static uint32_t expected[M * K / 32];
+
+static int failures = 0;
+
+static void testBits(uint8_t bitsA, uint8_t bitsB, uint32_t* seed){
+    BitPlaneMatrix_t a;
+    BitPlaneMatrix_t b;
+    if(!allocBitPlaneMatrix(&a, M, N, bitsA, BITPLANE_BIPOLAR) || !allocBitPlaneMatrix(&b, N, K, bitsB, BITPLANE_BIPOLAR)){
+        printf("[FAIL] allocation\n");
+        ++failures;
+        return;
+    }
+    for(int i = 0; i < M * N; ++i){
+        *seed = *seed * 1664525u + 1013904223u;
+        codesA[i] = (*seed >> 24) & ((1 << bitsA) - 1);
+    }
+    for(int i = 0; i < N * K; ++i){
+        *seed = *seed * 1664525u + 1013904223u;
+        codesB[i] = (*seed >> 24) & ((1 << bitsB) - 1);
+    }
+    packBitPlanes(codesA, &a);
+    packBitPlanes(codesB, &b);
+
+    const int32_t bias = N * ((1 << bitsA) - 1) * ((1 << bitsB) - 1);
+    const int32_t thresholds[] = {0, 37, -64, bias / 4, -bias - 1};
+    for(int t = 0; t < sizeof(thresholds) / sizeof(thresholds[0]); ++t){
+        fastLowBitMatrixMul(&a, &b, expected, thresholds[t]);
+        memset(c, 0, sizeof(c));
+        if(!lowBitMatrixMulBTPU(&device, &a, &b, c, thresholds[t]) || memcmp(c, expected, sizeof(c)) != 0){
+            printf("[FAIL] bitsA = %u, bitsB = %u, threshold = %d\n", bitsA, bitsB, thresholds[t]);
+            ++failures;
+        }
+    }
+    freeBitPlaneMatrix(&a);
+    freeBitPlaneMatrix(&b);
+}
+
+int main(){
+    uint32_t seed = 7;
+    testBits(1, 1, &seed);
+    testBits(2, 2, &seed);
+    testBits(3, 2, &seed);
+
+    if(failures == 0){
+        printf("All tests passed\n");
+    }
+    return failures == 0 ? 0 : 1;
+}
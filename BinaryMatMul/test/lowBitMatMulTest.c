@@ -0,0 +1,112 @@
+/*!
+    @file       lowBitMatMulTest.c
+    @brief      Test su host di lowBitMatrixMul e fastLowBitMatrixMul contro un riferimento intero naive.
+    @details    Copre tutte le combinazioni di codifica (senza segno, bipolare e miste), da cui dipendono i termini di
+                correzione dell'AND-popcount, per diverse larghezze dei plane.
+
+    @author     Alan Masutti  (@alanmasu)
+    @date       18/10/2026
+*/
+
+#include <BinaryMatMul.h>
+#include <BinaryLowBitMatMul.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define M 64
+#define N 96
+#define K 64
+
+static uint8_t  codesA[M * N];
+static uint8_t  codesB[N * K];
+static int32_t  result[M * K];
+static int32_t  expected[M * K];
+static uint32_t c[M * K / 32];
+
+static int failures = 0;
+
+/// Valore rappresentato da un codice, calcolato direttamente dalla definizione della codifica
+static int32_t naiveValue(uint8_t code, uint8_t bits, BitPlaneEncoding_t encoding){
+    int32_t value = 0;
+    for(int p = 0; p < bits; ++p){
+        const int32_t bit = (code >> p) & 1;
+        value += (1 << p) * (encoding == BITPLANE_BIPOLAR ? 2 * bit - 1 : bit);
+    }
+    return value;
+}
+
+static void naiveMatrixMul(uint8_t bitsA, BitPlaneEncoding_t encA, uint8_t bitsB, BitPlaneEncoding_t encB){
+    for(int i = 0; i < M; ++i){
+        for(int j = 0; j < K; ++j){
+            int32_t sum = 0;
+            for(int l = 0; l < N; ++l){
+                sum += naiveValue(codesA[i * N + l], bitsA, encA) * naiveValue(codesB[l * K + j], bitsB, encB);
+            }
+            expected[i * K + j] = sum;
+        }
+    }
+}
+
+static void testEncodings(uint8_t bitsA, BitPlaneEncoding_t encA, uint8_t bitsB, BitPlaneEncoding_t encB, uint32_t* seed){
+    BitPlaneMatrix_t a;
+    BitPlaneMatrix_t b;
+    if(!allocBitPlaneMatrix(&a, M, N, bitsA, encA) || !allocBitPlaneMatrix(&b, N, K, bitsB, encB)){
+        printf("[FAIL] allocation\n");
+        ++failures;
+        return;
+    }
+    for(int i = 0; i < M * N; ++i){
+        *seed = *seed * 1664525u + 1013904223u;
+        codesA[i] = (*seed >> 24) & ((1 << bitsA) - 1);
+    }
+    for(int i = 0; i < N * K; ++i){
+        *seed = *seed * 1664525u + 1013904223u;
+        codesB[i] = (*seed >> 24) & ((1 << bitsB) - 1);
+    }
+    packBitPlanes(codesA, &a);
+    packBitPlanes(codesB, &b);
+    naiveMatrixMul(bitsA, encA, bitsB, encB);
+
+    lowBitMatrixMul(&a, &b, result);
+    if(memcmp(result, expected, sizeof(result)) != 0){
+        printf("[FAIL] lowBitMatrixMul, bitsA = %u (enc %d), bitsB = %u (enc %d)\n", bitsA, encA, bitsB, encB);
+        ++failures;
+    }
+
+    const int32_t thresholds[] = {0, 17, -40};
+    for(int t = 0; t < sizeof(thresholds) / sizeof(thresholds[0]); ++t){
+        fastLowBitMatrixMul(&a, &b, c, thresholds[t]);
+        bool ok = true;
+        for(int i = 0; i < M && ok; ++i){
+            for(int j = 0; j < K && ok; ++j){
+                ok = getBit(c, i, j, K) == (expected[i * K + j] > thresholds[t]);
+            }
+        }
+        if(!ok){
+            printf("[FAIL] fastLowBitMatrixMul, bitsA = %u (enc %d), bitsB = %u (enc %d), threshold = %d\n",
+                   bitsA, encA, bitsB, encB, thresholds[t]);
+            ++failures;
+        }
+    }
+    freeBitPlaneMatrix(&a);
+    freeBitPlaneMatrix(&b);
+}
+
+int main(){
+    uint32_t seed = 11;
+    const BitPlaneEncoding_t encodings[] = {BITPLANE_UNSIGNED, BITPLANE_BIPOLAR};
+    for(int ea = 0; ea < 2; ++ea){
+        for(int eb = 0; eb < 2; ++eb){
+            testEncodings(1, encodings[ea], 1, encodings[eb], &seed);
+            testEncodings(2, encodings[ea], 2, encodings[eb], &seed);
+            testEncodings(4, encodings[ea], 3, encodings[eb], &seed);
+        }
+    }
+
+    if(failures == 0){
+        printf("All tests passed\n");
+    }
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,95 @@
+/*!
+    @file       plannerTest.c
+    @brief      Test su host della cache dei piani del planner.
+    @details    Alterna piu' forme di quante ne contenga la cache: ogni forma deve essere misurata al piu' una volta,
+                le forme oltre la capacita' devono usare il piano predefinito senza tuning e tutti i risultati devono
+                coincidere con il kernel software.
+
+    @author     Alan Masutti  (@alanmasu)
+    @date       18/10/2026
+*/
+
+#include <BinaryMatMul.h>
+#include <BinaryMatMulPlanner.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define SHAPES      (BINARY_PLANNER_CACHE_SIZE + 1)
+#define ROUNDS      3
+#define N           64
+#define K           64
+#define MAX_M       (SHAPES * BINARY_FRAG_SIZE)
+#define SIGN_CMP    30
+
+static BinaryPanelWorkspace_t workspace;
+
+static uint32_t a[MAX_M * N / 32];
+static uint32_t b[N * K / 32];
+static uint32_t c[MAX_M * K / 32];
+static uint32_t expected[MAX_M * K / 32];
+
+static int failures = 0;
+static uint64_t timerCalls = 0;
+
+static void check(bool condition, const char* what){
+    if(!condition){
+        printf("[FAIL] %s\n", what);
+        ++failures;
+    }
+}
+
+/// Timer fittizio che conta le chiamate: ogni chiamata corrisponde a una misura di tuning
+static uint64_t countingTimer(void){
+    return timerCalls++;
+}
+
+int main(){
+    uint32_t seed = 13;
+    for(int i = 0; i < MAX_M * N / 32; ++i){
+        seed = seed * 1664525u + 1013904223u;
+        a[i] = seed;
+    }
+    for(int i = 0; i < N * K / 32; ++i){
+        seed = seed * 1664525u + 1013904223u;
+        b[i] = seed;
+    }
+
+    binaryPlannerClearCache();
+    binaryPlannerSetWorkspace(&workspace);
+    binaryPlannerSetTimer(countingTimer);
+
+    uint64_t firstRoundCalls = 0;
+    for(int round = 0; round < ROUNDS; ++round){
+        const uint64_t before = timerCalls;
+        for(int s = 0; s < SHAPES; ++s){
+            const int m = (s + 1) * BINARY_FRAG_SIZE;
+            memset(c, 0, sizeof(c));
+            fastBinaryMatrixMul(a, b, c, SIGN_CMP, m, N, K);
+            fastBinaryMatrixMulPanel(a, b, expected, SIGN_CMP, m, N, K, 0, NULL);
+            check(memcmp(c, expected, m * K / 8) == 0, "planned result");
+        }
+        if(round == 0){
+            firstRoundCalls = timerCalls - before;
+        }else{
+            check(timerCalls == before, "no tuning after the first round");
+        }
+    }
+    check(firstRoundCalls > 0, "shapes tuned in the first round");
+
+    // Le prime BINARY_PLANNER_CACHE_SIZE forme sono in cache, quella in eccesso no
+    for(int s = 0; s < SHAPES; ++s){
+        const BinaryMatMulPlan_t* plan = binaryPlannerGetPlan((s + 1) * BINARY_FRAG_SIZE, N, K, true);
+        check(s < BINARY_PLANNER_CACHE_SIZE ? plan != NULL : plan == NULL, "cache capacity without eviction");
+    }
+
+    binaryPlannerSetTimer(NULL);
+    binaryPlannerSetWorkspace(NULL);
+    binaryPlannerClearCache();
+
+    if(failures == 0){
+        printf("All tests passed\n");
+    }
+    return failures == 0 ? 0 : 1;
+}
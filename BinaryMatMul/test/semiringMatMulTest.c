@@ -0,0 +1,86 @@
+/*!
+    @file       semiringMatMulTest.c
+    @brief      Test su host di gf2MatrixMul e booleanMatrixMul contro un riferimento naive bit per bit.
+    @details    Il semianello booleano viene provato con operandi sparsi, cosi' che l'uscita non sia tutta a 1.
+
+    @author     Alan Masutti  (@alanmasu)
+    @date       18/10/2026
+*/
+
+#include <BinaryMatMul.h>
+#include <BinarySemiringMatMul.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define M 64
+#define N 96
+#define K 64
+
+static BinaryM4RWorkspace_t workspace;
+
+static uint32_t a[M * N / 32];
+static uint32_t b[N * K / 32];
+static uint32_t c[M * K / 32];
+
+static int failures = 0;
+
+/// Parola casuale con ogni bit a 1 con probabilita' 1 / 2^sparsity
+static uint32_t randomWord(uint32_t* seed, int sparsity){
+    uint32_t word = 0xFFFFFFFFu;
+    for(int s = 0; s <= sparsity; ++s){
+        *seed = *seed * 1664525u + 1013904223u;
+        word &= *seed;
+    }
+    return word;
+}
+
+static void testSemiring(BinarySemiring_t semiring, int sparsity, uint32_t* seed){
+    for(int i = 0; i < M * N / 32; ++i){
+        a[i] = randomWord(seed, sparsity);
+    }
+    for(int i = 0; i < N * K / 32; ++i){
+        b[i] = randomWord(seed, sparsity);
+    }
+    memset(c, 0xA5, sizeof(c));
+    if(semiring == BINARY_SEMIRING_GF2){
+        gf2MatrixMul(a, b, c, M, N, K, &workspace);
+    }else{
+        booleanMatrixMul(a, b, c, M, N, K, &workspace);
+    }
+
+    bool ok = true;
+    uint32_t ones = 0;
+    for(int i = 0; i < M && ok; ++i){
+        for(int j = 0; j < K && ok; ++j){
+            uint8_t expected = 0;
+            for(int l = 0; l < N; ++l){
+                const uint8_t term = getBit(a, i, l, N) & getBit(b, l, j, K);
+                expected = semiring == BINARY_SEMIRING_GF2 ? expected ^ term : expected | term;
+            }
+            ok = getBit(c, i, j, K) == expected;
+            ones += expected;
+        }
+    }
+    if(!ok){
+        printf("[FAIL] semiring %d, sparsity %d\n", semiring, sparsity);
+        ++failures;
+    }else if(ones == 0 || ones == M * K){
+        printf("[FAIL] semiring %d, sparsity %d: constant output, test not meaningful\n", semiring, sparsity);
+        ++failures;
+    }
+}
+
+int main(){
+    uint32_t seed = 21;
+    testSemiring(BINARY_SEMIRING_GF2, 0, &seed);
+    testSemiring(BINARY_SEMIRING_GF2, 2, &seed);
+    testSemiring(BINARY_SEMIRING_BOOLEAN, 3, &seed);
+    testSemiring(BINARY_SEMIRING_BOOLEAN, 4, &seed);
+
+    if(failures == 0){
+        printf("All tests passed\n");
+    }
+    return failures == 0 ? 0 : 1;
+}
@@ -3,6 +3,9 @@
 #include <string.h>
 #include "pico/stdlib.h"
 #include <BinaryMatMul.h>
+#include <BinaryMatMulPlanner.h>
+#include <BinaryHammingSearch.h>
+#include <BinaryStream.h>
 
 #include "hardware/clocks.h"
 #include "hardware/pll.h"
@@ -65,18 +68,23 @@ void set_sys_clock_40mhz() {
 }
 
 #define ITERATIONS 5
-#define TIMES_NUM 9
+#define TIMES_NUM 10
 
 absolute_time_t times[TIMES_NUM * ITERATIONS] = {0};
 absolute_time_t startTime = 0;
 uint32_t sizes[ITERATIONS] = {0};
+uint32_t panels[ITERATIONS] = {0};
 uint32_t sizeIndex = 0;
 uint32_t timesIndex = 0;
 uint32_t testN = 0;
 
+/// Buffer dei pannelli per binaryMatrixMul/fastBinaryMatrixMul (usati da un solo core)
+BinaryPanelWorkspace_t panelWorkspace;
+
 char labels[TIMES_NUM][25] = {
     "Allocazione",
     "Popolazione",
+    "Pianificazione",
     "Caricamento",
     "Settaggio",
     "Inizializzazione",
@@ -91,7 +99,7 @@ void printResults(){
     for(int label = 0; label < TIMES_NUM - 1; ++label){
         printf("%s,", labels[label]);
     }
-    printf("%s,platform\n", labels[TIMES_NUM - 1]);
+    printf("%s,panelBlocks,platform\n", labels[TIMES_NUM - 1]);
     
     absolute_time_t toPrint = 0;
     for(int size = 0; size < sizeIndex; ++size){
@@ -105,10 +113,185 @@ void printResults(){
             printf("%llu,", toPrint);
         }
         toPrint = absolute_time_diff_us(times[size * TIMES_NUM + TIMES_NUM - 2], times[size * TIMES_NUM + TIMES_NUM - 1]);
-        printf("%llu,RP2350\n", toPrint);
+        printf("%llu,%u,RP2350\n", toPrint, panels[size]);
+    }
+}
+
+#define HAMMING_DB_SIZE 1024
+#define HAMMING_DIM     128
+#define HAMMING_QUERIES 16
+
+/// Confronta la ricerca per distanza di Hamming (naive, forza bruta con early-abandon, MIH) e stampa i tempi in CSV
+void benchHammingSearch(){
+    const uint32_t words = HAMMING_DIM / 32;
+    BinaryMatrix_t vectors = (BinaryMatrix_t)malloc(HAMMING_DB_SIZE * words * sizeof(uint32_t));
+    BinaryMatrix_t queries = (BinaryMatrix_t)malloc(HAMMING_QUERIES * words * sizeof(uint32_t));
+    uint32_t naiveIndices[HAMMING_QUERIES];
+    uint32_t naiveDistances[HAMMING_QUERIES];
+    uint32_t bruteIndices[HAMMING_QUERIES];
+    uint32_t bruteDistances[HAMMING_QUERIES];
+    uint32_t mihIndices[HAMMING_QUERIES];
+    uint32_t mihDistances[HAMMING_QUERIES];
+    HammingDatabase_t db;
+    HammingIndex_t index;
+
+    if(!vectors || !queries){
+        PRINTF_ERR("[ERROR]: Memory allocation failed for Hamming benchmark!\n");
+        free(vectors);
+        free(queries);
+        return;
+    }
+
+    uint32_t seed = 1;
+    for(int i = 0; i < HAMMING_DB_SIZE * words; ++i){
+        seed = seed * 1664525u + 1013904223u;
+        vectors[i] = seed;
+    }
+    // Query vicine al database: un vettore con un bit invertito per parola
+    for(int q = 0; q < HAMMING_QUERIES; ++q){
+        for(int i = 0; i < words; ++i){
+            queries[q * words + i] = vectors[(q * 61 % HAMMING_DB_SIZE) * words + i] ^ (1u << (q + i));
+        }
+    }
+
+    if(!hammingDatabaseLoad(&db, vectors, HAMMING_DB_SIZE, HAMMING_DIM)){
+        PRINTF_ERR("[ERROR]: Memory allocation failed for Hamming database!\n");
+        free(vectors);
+        free(queries);
+        return;
+    }
+    bool indexed = hammingIndexBuild(&index, &db);
+
+    absolute_time_t start = get_absolute_time();
+    for(int q = 0; q < HAMMING_QUERIES; ++q){
+        uint32_t bestDist = UINT32_MAX;
+        for(int v = 0; v < HAMMING_DB_SIZE; ++v){
+            uint32_t d = 0;
+            for(int i = 0; i < words; ++i){
+                d += BINARY_FRAG_SIZE - binaryMul(queries[q * words + i], vectors[v * words + i]);
+            }
+            if(d < bestDist){
+                bestDist = d;
+                naiveIndices[q] = v;
+            }
+        }
+        naiveDistances[q] = bestDist;
+    }
+    absolute_time_t naiveEnd = get_absolute_time();
+    hammingKnnSearch(&db, queries, HAMMING_QUERIES, 1, bruteIndices, bruteDistances);
+    absolute_time_t bruteEnd = get_absolute_time();
+    if(indexed){
+        hammingIndexSearch(&index, queries, HAMMING_QUERIES, 1, mihIndices, mihDistances);
+    }
+    absolute_time_t mihEnd = get_absolute_time();
+
+    // A parita' di distanza vince l'indice minore in tutte e tre le ricerche, quindi i risultati devono coincidere
+    bool match = true;
+    for(int q = 0; q < HAMMING_QUERIES; ++q){
+        if(bruteIndices[q] != naiveIndices[q] || bruteDistances[q] != naiveDistances[q]){
+            match = false;
+            PRINTF_ERR("[ERROR]: Brute force mismatch on query %d: %u (%u) instead of %u (%u)\n", q,
+                       bruteIndices[q], bruteDistances[q], naiveIndices[q], naiveDistances[q]);
+        }
+        if(indexed && (mihIndices[q] != naiveIndices[q] || mihDistances[q] != naiveDistances[q])){
+            match = false;
+            PRINTF_ERR("[ERROR]: MIH mismatch on query %d: %u (%u) instead of %u (%u)\n", q,
+                       mihIndices[q], mihDistances[q], naiveIndices[q], naiveDistances[q]);
+        }
+    }
+
+    // I tempi vengono stampati solo se le tre ricerche hanno restituito gli stessi vicini
+    if(match){
+        printf("dbSize,dim,queries,Naive,ForzaBruta,MIH,platform\n");
+        printf("%d,%d,%d,%llu,%llu,%llu,RP2350\n", HAMMING_DB_SIZE, HAMMING_DIM, HAMMING_QUERIES,
+               absolute_time_diff_us(start, naiveEnd), absolute_time_diff_us(naiveEnd, bruteEnd),
+               indexed ? absolute_time_diff_us(bruteEnd, mihEnd) : 0);
+    }
+
+    if(indexed){
+        hammingIndexFree(&index);
+    }
+    hammingDatabaseFree(&db);
+    free(vectors);
+    free(queries);
+}
+
+#define STREAM_STRIPS 64
+#define STREAM_N      1024
+#define STREAM_HIDDEN 256
+#define STREAM_K      32
+
+/// Conta i bit a 1 delle strisce di uscita, per evitare che il calcolo venga eliminato
+void streamStripCb(const uint32_t* strip, uint32_t rows, void* ctx){
+    uint32_t* ones = (uint32_t*)ctx;
+    for(int i = 0; i < rows * (STREAM_K / 32); ++i){
+        *ones += popcount32(strip[i]);
     }
 }
 
+/// Esegue due layer in streaming su STREAM_STRIPS strisce e stampa tempo totale e latenza massima per striscia in CSV
+void benchStreaming(){
+    BinaryMatrix_t w0 = (BinaryMatrix_t)malloc(STREAM_N * STREAM_HIDDEN / 32 * sizeof(uint32_t));
+    BinaryMatrix_t w1 = (BinaryMatrix_t)malloc(STREAM_HIDDEN * STREAM_K / 32 * sizeof(uint32_t));
+    BinaryMatrix_t strip = (BinaryMatrix_t)malloc(BINARY_FRAG_SIZE * STREAM_N / 32 * sizeof(uint32_t));
+    BinaryWeights_t pw0 = {0};
+    BinaryWeights_t pw1 = {0};
+    BinaryStream_t stream;
+    uint32_t ones = 0;
+    uint32_t seed = 1;
+
+    binaryStreamInit(&stream, streamStripCb, &ones);
+    if(!w0 || !w1 || !strip){
+        PRINTF_ERR("[ERROR]: Memory allocation failed for streaming benchmark!\n");
+        goto cleanup;
+    }
+    for(int i = 0; i < STREAM_N * STREAM_HIDDEN / 32; ++i){
+        seed = seed * 1664525u + 1013904223u;
+        w0[i] = seed;
+    }
+    for(int i = 0; i < STREAM_HIDDEN * STREAM_K / 32; ++i){
+        seed = seed * 1664525u + 1013904223u;
+        w1[i] = seed;
+    }
+    if(!prepareBinaryWeights(&pw0, w0, STREAM_N, STREAM_HIDDEN) || !prepareBinaryWeights(&pw1, w1, STREAM_HIDDEN, STREAM_K) ||
+       !binaryStreamAddLayer(&stream, &pw0, STREAM_N / 2, false) || !binaryStreamAddLayer(&stream, &pw1, STREAM_HIDDEN / 2, false)){
+        PRINTF_ERR("[ERROR]: Streaming pipeline setup failed!\n");
+        goto cleanup;
+    }
+    // Le matrici originali dei pesi non servono piu': restano solo i pesi preparati
+    free(w0);
+    free(w1);
+    w0 = NULL;
+    w1 = NULL;
+
+    uint64_t maxLatency = 0;
+    absolute_time_t start = get_absolute_time();
+    for(int s = 0; s < STREAM_STRIPS; ++s){
+        // Simula l'arrivo di una striscia dal sensore
+        for(int i = 0; i < BINARY_FRAG_SIZE * STREAM_N / 32; ++i){
+            seed = seed * 1664525u + 1013904223u;
+            strip[i] = seed;
+        }
+        absolute_time_t stripStart = get_absolute_time();
+        binaryStreamPush(&stream, strip, BINARY_FRAG_SIZE);
+        uint64_t latency = absolute_time_diff_us(stripStart, get_absolute_time());
+        maxLatency = latency > maxLatency ? latency : maxLatency;
+    }
+    absolute_time_t end = get_absolute_time();
+
+    printf("strips,n,hidden,k,Totale,LatenzaMax,ones,platform\n");
+    printf("%d,%d,%d,%d,%llu,%llu,%u,RP2350\n", STREAM_STRIPS, STREAM_N, STREAM_HIDDEN, STREAM_K,
+           absolute_time_diff_us(start, end), maxLatency, ones);
+
+cleanup:
+    binaryStreamFree(&stream);
+    freeBinaryWeights(&pw0);
+    freeBinaryWeights(&pw1);
+    free(w0);
+    free(w1);
+    free(strip);
+}
+
 int main(){
     
     pico_led_init();
@@ -118,6 +301,9 @@ int main(){
     stdio_init_all();
     printf("Running at %u KHz\n", frequency_count_khz(CLOCKS_FC0_SRC_VALUE_CLK_SYS));
 
+    binaryPlannerSetTimer(time_us_64);
+    binaryPlannerSetWorkspace(&panelWorkspace);
+
     int bn = 0;
     const uint32_t signCmp = 48;
 
@@ -169,6 +355,12 @@ int main(){
 
         times[timesIndex++] = get_absolute_time(); // Popolazione
 
+        // La prima chiamata misura le varianti del kernel e memorizza il piano per questa forma
+        fastBinaryMatrixMul(A, W, OSerial, signCmp, n, n, n);
+        const BinaryMatMulPlan_t* plan = binaryPlannerGetPlan(n, n, n, true);
+        panels[sizeIndex - 1] = plan ? plan->panelBlocks : 0;
+        times[timesIndex++] = get_absolute_time(); // Pianificazione
+
         loadBinaryMatrixToFragments(A, BTPU0_IO0_MEMORY, n, n);
         loadBinaryMatrixToFragments(W, BTPU0_W_MEMORY, n, n);
         times[timesIndex++] = get_absolute_time(); // Caricamento
@@ -218,6 +410,9 @@ int main(){
     PRINTF_LOG("\nAll tests completed!\n");
     printResults();
 
+    benchHammingSearch();
+    benchStreaming();
+
     while (true) {
         // printf("Hello, world!\n");
         sleep_ms(1000);